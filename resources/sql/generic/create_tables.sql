@@ -2,10 +2,10 @@
 ---------------------- Tags ---------------------
 -------------------------------------------------
 CREATE TABLE IF NOT EXISTS tags (
-      uuid          VARCHAR(36)  PRIMARY KEY
+      uuid          BLOB         PRIMARY KEY
     , name          VARCHAR(128) NOT NULL
     , color         VARCHAR(9)
-    , parent_uuid   VARCHAR(36)
+    , parent_uuid   BLOB
     , last_modified VARCHAR(30)
     , FOREIGN KEY (parent_uuid) REFERENCES tags(uuid) ON DELETE CASCADE
 );
@@ -40,7 +40,7 @@ FOR EACH ROW
 --------------------- Tasks ---------------------
 -------------------------------------------------
 CREATE TABLE IF NOT EXISTS tasks (
-      uuid             VARCHAR(36)   PRIMARY KEY
+      uuid             BLOB          PRIMARY KEY
     , title            VARCHAR(1024) NOT NULL
     , status           VARCHAR(10)   NOT NULL DEFAULT 'open'
                                      CHECK(status IN ('open', 'closed'))
@@ -106,11 +106,11 @@ FOR EACH ROW
 -------------- Media-Task Relation --------------
 -------------------------------------------------
 CREATE TABLE IF NOT EXISTS task_media (
-      task_uuid     VARCHAR(36)
+      task_uuid     BLOB
     , media_hash    VARCHAR(64)
     , last_modified VARCHAR(30)
     , PRIMARY KEY (task_uuid, media_hash)
-    , FOREIGN KEY (task_uuid)  REFERENCES atasks (uuid)       ON DELETE CASCADE
+    , FOREIGN KEY (task_uuid)  REFERENCES tasks (uuid)        ON DELETE CASCADE
     , FOREIGN KEY (media_hash) REFERENCES media (media_hash) ON DELETE CASCADE
 );
 
@@ -129,8 +129,8 @@ FOR EACH ROW
 ---------------- Tag Assignments ----------------
 -------------------------------------------------
 CREATE TABLE IF NOT EXISTS tag_assignments (
-      task_uuid     VARCHAR(36)
-    , tag_uuid      VARCHAR(36)
+      task_uuid     BLOB
+    , tag_uuid      BLOB
     , last_modified VARCHAR(30)
     , PRIMARY KEY (task_uuid, tag_uuid)
     , FOREIGN KEY (task_uuid)           REFERENCES tasks (uuid) ON DELETE CASCADE
@@ -152,8 +152,8 @@ FOR EACH ROW
 --------------- Task Dependencies ---------------
 -------------------------------------------------
 CREATE TABLE IF NOT EXISTS dependencies (
-      dependent_uuid    VARCHAR(36)
-    , prerequisite_uuid VARCHAR(36)
+      dependent_uuid    BLOB
+    , prerequisite_uuid BLOB
         NOT NULL
         CHECK(prerequisite_uuid != dependent_uuid)
     , last_modified VARCHAR(30)
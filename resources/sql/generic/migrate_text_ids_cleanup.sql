@@ -0,0 +1,11 @@
+-- Drop the tables renamed by migrate_text_ids_prepare.sql once their data has been copied.
+-- Dependent tables are dropped first to avoid foreign key violations.
+DROP TABLE dependencies_text_ids;
+
+DROP TABLE tag_assignments_text_ids;
+
+DROP TABLE task_media_text_ids;
+
+DROP TABLE tasks_text_ids;
+
+DROP TABLE tags_text_ids;
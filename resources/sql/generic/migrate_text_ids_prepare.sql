@@ -0,0 +1,29 @@
+-- Databases created before ids were stored as 16 byte BLOBs use VARCHAR(36) text ids.
+-- Rename their tables and drop triggers and indices, such that create_tables.sql
+-- creates the new tables. Afterwards, the data is copied while converting the ids
+-- and the renamed tables are dropped by migrate_text_ids_cleanup.sql.
+DROP TRIGGER IF EXISTS tags_insert_last_modified;
+
+DROP TRIGGER IF EXISTS tags_update_last_modified;
+
+DROP TRIGGER IF EXISTS tasks_insert_last_modified;
+
+DROP TRIGGER IF EXISTS tasks_update_last_modified;
+
+DROP TRIGGER IF EXISTS task_media_insert_last_modified;
+
+DROP TRIGGER IF EXISTS tag_assignments_insert_last_modified;
+
+DROP TRIGGER IF EXISTS dependencies_insert_last_modified;
+
+DROP INDEX IF EXISTS index_tasks_status_due_datetime;
+
+ALTER TABLE tags RENAME TO tags_text_ids;
+
+ALTER TABLE tasks RENAME TO tasks_text_ids;
+
+ALTER TABLE task_media RENAME TO task_media_text_ids;
+
+ALTER TABLE tag_assignments RENAME TO tag_assignments_text_ids;
+
+ALTER TABLE dependencies RENAME TO dependencies_text_ids;
@@ -1,4 +1,6 @@
+-- Dependencies are selected in insertion order, which determines the order of siblings
 SELECT
       dependent_uuid
     , prerequisite_uuid
-FROM dependencies;
+FROM dependencies
+ORDER BY rowid;
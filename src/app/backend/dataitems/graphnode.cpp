@@ -0,0 +1,127 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "graphnode.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <QVariant>
+
+#include "qtdid.h"
+#include "uniquedataitem.h"
+
+GraphNode::GraphNode(std::unique_ptr<UniqueDataItem> data)
+    : data(std::move(data)) {}
+
+QtdId GraphNode::get_uuid() const {
+    return this->data->get_uuid();
+}
+
+QVariant GraphNode::get_data(int role) const {
+    return this->data->get_data(role);
+}
+
+void GraphNode::set_data(const QVariant& value, int role) {
+    this->data->set_data(value, role);
+}
+
+int GraphNode::get_child_count() const {
+    return static_cast<int>(this->children.size());
+}
+
+GraphNode* GraphNode::get_child(int row) const {
+    return this->children.at(row);
+}
+
+const std::vector<GraphNode*>& GraphNode::get_parents() const {
+    return this->parents;
+}
+
+void GraphNode::add_child(GraphNode* child) {
+    child->parents.push_back(this);
+    this->children.push_back(child);
+}
+
+/**
+ * @brief Remove the edge to a child; the child may be destroyed if it has no parents left.
+ */
+GraphNode* GraphNode::take_child(int row) {
+    auto* child = this->children.at(row);
+    this->children.erase(this->children.begin() + row);
+    child->parents.erase(std::ranges::find(child->parents, this));
+    return child;
+}
+
+/**
+ * @brief Announce that the children at the given rows are about to be taken.
+ *
+ * The TreeNodes of this node remove the rows first, from the last to the first one, and
+ * only then the edges are taken. Meanwhile, the empty slots of the TreeNodes are mapped
+ * past the rows they have already removed using get_remaining_child_row.
+ */
+void GraphNode::begin_child_removal(std::vector<int> rows) {
+    std::ranges::sort(rows);
+    this->rows_being_removed = std::move(rows);
+}
+
+void GraphNode::end_child_removal() {
+    this->rows_being_removed.clear();
+}
+
+bool GraphNode::is_removing_children() const {
+    return !this->rows_being_removed.empty();
+}
+
+/**
+ * @brief Map a row of a TreeNode that has already removed the last removed_count of the
+ *        announced rows to the row of the same child in this node.
+ */
+int GraphNode::get_remaining_child_row(int row, int removed_count) const {
+    auto graph_row = row;
+    const auto end = this->rows_being_removed.end();
+    for (auto removed_row = end - removed_count; removed_row != end; ++removed_row) {
+        if (*removed_row > graph_row) {
+            break;
+        }
+        graph_row++;
+    }
+    return graph_row;
+}
+
+const std::vector<TreeNode*>& GraphNode::get_tree_nodes() const {
+    return this->tree_nodes;
+}
+
+void GraphNode::add_tree_node(TreeNode* tree_node) {
+    this->tree_nodes.push_back(tree_node);
+}
+
+void GraphNode::remove_tree_node(const TreeNode* tree_node) {
+    this->tree_nodes.erase(std::ranges::find(this->tree_nodes, tree_node));
+}
+
+qsizetype GraphNode::get_topological_rank() const {
+    return this->topological_rank;
+}
+
+void GraphNode::set_topological_rank(qsizetype rank) {
+    this->topological_rank = rank;
+}
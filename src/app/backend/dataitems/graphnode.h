@@ -0,0 +1,84 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QVariant>
+#include <QtTypes>
+
+#include "qtdid.h"
+#include "uniquedataitem.h"
+
+class TreeNode;
+
+/**
+ * @brief A data item in the dependency graph together with its dependencies (children).
+ *
+ * Every data item is stored in exactly one GraphNode, no matter how many dependents it
+ * has. GraphNodes are allocated and destroyed by their TreeItemModel; the list of
+ * parents doubles as an intrusive reference count: a node whose last parent has been
+ * removed is no longer referenced and may be destroyed. The TreeNodes that currently
+ * represent the node in a tree are registered with it, so that changes can be announced
+ * for each of them.
+ *
+ * The model keeps the nodes in topological order: the rank of a node is larger than
+ * the ranks of all of its parents.
+ */
+class GraphNode {
+
+private:
+    std::unique_ptr<UniqueDataItem> data;
+    std::vector<GraphNode*> children;
+    std::vector<GraphNode*> parents;     // One entry per edge
+    std::vector<TreeNode*> tree_nodes;
+    std::vector<int> rows_being_removed; // Ascending, see begin_child_removal
+    qsizetype topological_rank = 0;
+
+public:
+    explicit GraphNode(std::unique_ptr<UniqueDataItem> data);
+    GraphNode(const GraphNode&)            = delete;
+    GraphNode(GraphNode&&)                 = delete;
+    GraphNode& operator=(const GraphNode&) = delete;
+    GraphNode& operator=(GraphNode&&)      = delete;
+    ~GraphNode() = default;
+
+    [[nodiscard]] QtdId get_uuid() const;
+    [[nodiscard]] QVariant get_data(int role) const;
+    void set_data(const QVariant& value, int role);
+
+    [[nodiscard]] int get_child_count() const;
+    [[nodiscard]] GraphNode* get_child(int row) const;
+    [[nodiscard]] const std::vector<GraphNode*>& get_parents() const;
+    void add_child(GraphNode* child);
+    GraphNode* take_child(int row);
+
+    void begin_child_removal(std::vector<int> rows);
+    void end_child_removal();
+    [[nodiscard]] bool is_removing_children() const;
+    [[nodiscard]] int get_remaining_child_row(int row, int removed_count) const;
+
+    [[nodiscard]] const std::vector<TreeNode*>& get_tree_nodes() const;
+    void add_tree_node(TreeNode* tree_node);
+    void remove_tree_node(const TreeNode* tree_node);
+
+    [[nodiscard]] qsizetype get_topological_rank() const;
+    void set_topological_rank(qsizetype rank);
+};
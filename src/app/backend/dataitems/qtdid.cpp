@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -20,12 +20,16 @@
 
 #include <cstddef>
 
+#include <QByteArray>
 #include <QString>
 #include <QUuid>
 #include <QVariant>
 
-size_t qHash(const QtdId& qtd_id) {
-    return qHash(qtd_id.toString());
+/**
+ * @brief Hash the 128 bits of the underlying uuid directly without creating a string representation.
+ */
+size_t qHash(const QtdId& qtd_id, size_t seed) noexcept {
+    return qHash(qtd_id.uuid, seed);
 }
 
 QtdId::QtdId(const QUuid& uuid) : uuid(uuid) {}
@@ -38,6 +42,13 @@ QtdId QtdId::create() {
     return QtdId(QUuid::createUuid());
 }
 
+/**
+ * @brief Create an id from its 16 byte binary representation as stored in the database.
+ */
+QtdId QtdId::from_bytes(const QByteArray& bytes) {
+    return QtdId(QUuid::fromRfc4122(bytes));
+}
+
 QtdId::operator QVariant() const {
     return
         this->is_valid()
@@ -61,6 +72,10 @@ QString QtdId::toString() const {
     return uuid.toString(QUuid::WithoutBraces);
 }
 
+QByteArray QtdId::to_bytes() const {
+    return uuid.toRfc4122();
+}
+
 bool QtdId::is_valid() const {
     return !uuid.isNull();
 }
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -20,6 +20,7 @@
 
 #include <cstddef>
 
+#include <QByteArray>
 #include <QString>
 #include <QUuid>
 #include <QVariant>
@@ -40,6 +41,7 @@ public:
     virtual ~QtdId() = default;
 
     static QtdId create();
+    static QtdId from_bytes(const QByteArray& bytes);
 
     // NOLINTBEGIN (hicpp-explicit-conversions)
     QtdId(const QString& uuid);
@@ -50,12 +52,15 @@ public:
     bool operator<(const QtdId& other) const;
 
     [[nodiscard]] QString toString() const;
+    [[nodiscard]] QByteArray to_bytes() const;
     [[nodiscard]] bool is_valid() const;
+
+    friend size_t qHash(const QtdId& qtd_id, size_t seed) noexcept;
 };
 
 Q_DECLARE_METATYPE(QtdId)
 
-size_t qHash(const QtdId& qtd_id);
+size_t qHash(const QtdId& qtd_id, size_t seed = 0) noexcept;
 
 using TagId = QtdId;
 using TaskId = QtdId;
@@ -34,6 +34,7 @@ enum QtdItemDataRole : quint16 { \
     , TagsRole                   \
     , AddTagRole                 \
     , RemoveTagRole              \
+    , SearchTextRole             \
 };
 
 QTD_ITEM_DATA_ROLE
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -23,6 +23,7 @@
 #include <QVariant>
 #include <QVariantList>
 
+#include "qtdid.h"
 #include "uniquedataitem.h"
 
 Tag::Tag(QString name, const QColor& color, const QString& tag_id)
@@ -30,7 +31,7 @@ Tag::Tag(QString name, const QColor& color, const QString& tag_id)
 {}
 
 Tag::Tag(const QVariantList& args)
-    : Tag(args[0].toString(), args[1].value<QColor>(), args[2].toString())
+    : Tag(args[0].toString(), args[1].value<QColor>(), args[2].value<TagId>().toString())
 {}
 
 QString Tag::get_name() const {
@@ -18,21 +18,107 @@
 
 #include "task.h"
 
+#include <list>
 #include <memory>
+#include <optional>
 #include <stdexcept>
 #include <utility>
 
+#include <QCoreApplication>
 #include <QDateTime>
+#include <QHash>
 #include <QMetaEnum>
+#include <QPointer>
 #include <QSet>
 #include <QString>
 #include <QTextDocument>
+#include <QTextDocumentFragment>
+#include <QThread>
 #include <QVariantList>
 
 #include "qtdid.h"
 #include "qtditemdatarole.h"
 #include "uniquedataitem.h"
 
+namespace {
+
+/**
+ * @brief Owns the open text documents of the tasks, least recently used first.
+ */
+class TextDocumentCache {
+public:
+    struct Entry {
+        const Task* task;
+        std::unique_ptr<QTextDocument> document;
+    };
+
+    /**
+     * @brief Returns the document of the given task without marking it as used.
+     */
+    [[nodiscard]] QTextDocument* find(const Task* task) const {
+        const auto position = this->positions.constFind(task);
+        return (position != this->positions.cend()) ? position.value()->document.get() : nullptr;
+    }
+
+    /**
+     * @brief Marks the document of the given task as most recently used.
+     */
+    QTextDocument* touch(const Task* task) {
+        const auto position = this->positions.constFind(task);
+        if (position == this->positions.cend()) {
+            return nullptr;
+        }
+        this->entries.splice(this->entries.end(), this->entries, position.value());
+        return position.value()->document.get();
+    }
+
+    /**
+     * @brief Adds the document of a task as the most recently used one.
+     * @return The least recently used entry if too many documents are open.
+     */
+    std::optional<Entry> insert(const Task* task, std::unique_ptr<QTextDocument> document) {
+        this->positions.insert(task, this->entries.insert(this->entries.end(), {task, std::move(document)}));
+        if (std::cmp_less_equal(this->entries.size(), Task::max_open_text_documents)) {
+            return std::nullopt;
+        }
+        return this->take(this->entries.front().task);
+    }
+
+    std::optional<Entry> take(const Task* task) {
+        const auto position = this->positions.constFind(task);
+        if (position == this->positions.cend()) {
+            return std::nullopt;
+        }
+        const auto list_position = position.value();
+        Entry entry = std::move(*list_position);
+        this->entries.erase(list_position);
+        this->positions.erase(position);
+        return entry;
+    }
+
+    void replace(const Task* old_task, const Task* new_task) {
+        const auto position = this->positions.constFind(old_task);
+        if (position == this->positions.cend()) {
+            return;
+        }
+        const auto list_position = position.value();
+        list_position->task = new_task;
+        this->positions.erase(position);
+        this->positions.insert(new_task, list_position);
+    }
+
+private:
+    std::list<Entry> entries;
+    QHash<const Task*, std::list<Entry>::iterator> positions;
+};
+
+TextDocumentCache& get_text_document_cache() {
+    static TextDocumentCache cache;
+    return cache;
+}
+
+}
+
 Task::Task(
       QString        title
     , Status         status
@@ -43,27 +129,65 @@ Task::Task(
     , const QString& task_id
 ) : UniqueDataItem(task_id)
     , title(std::move(title))
-    , status(status)
+    , description_html(document_html)
     , start_date(std::move(start_date))
     , due_date(std::move(due_date))
     , resolve_date(std::move(resolve_date))
-{
-    this->description = std::make_unique<QTextDocument>();
-    this->description->setHtml(document_html);
-}
+    , status(status)
+{}
 
-Task::Task(Task&& other) noexcept
+/**
+ * @brief Copies the task including its id; the copy starts without an open text document.
+ */
+Task::Task(const Task& other)
     :
     UniqueDataItem(other),
-    title       (std::move(other.title)),
-    description (std::move(other.description)),
-    status      (          other.status),
-    start_date  (std::move(other.start_date)),
-    due_date    (std::move(other.due_date)),
-    resolve_date(std::move(other.resolve_date)),
-    tags        (std::move(other.tags))
+    title                       (other.title),
+    description_html            (other.get_description_html()),
+    description_plain_text      (other.description_plain_text),
+    search_text                 (other.search_text),
+    start_date                  (other.start_date),
+    due_date                    (other.due_date),
+    resolve_date                (other.resolve_date),
+    tags                        (other.tags),
+    status                      (other.status),
+    description_plain_text_valid(other.description_plain_text_valid),
+    search_text_valid           (other.search_text_valid)
 {}
 
+Task::Task(Task&& other) noexcept
+    :
+    UniqueDataItem(other),
+    title                       (std::move(other.title)),
+    description_html            (std::move(other.description_html)),
+    description_plain_text      (std::move(other.description_plain_text)),
+    search_text                 (std::move(other.search_text)),
+    start_date                  (std::move(other.start_date)),
+    due_date                    (std::move(other.due_date)),
+    resolve_date                (std::move(other.resolve_date)),
+    tags                        (std::move(other.tags)),
+    status                      (          other.status),
+    has_text_document           (          other.has_text_document),
+    description_plain_text_valid(          other.description_plain_text_valid),
+    search_text_valid           (          other.search_text_valid)
+{
+    if (this->has_text_document) {
+        auto& cache = get_text_document_cache();
+        cache.replace(&other, this);
+        other.has_text_document = false;
+
+        auto* document = cache.find(this);
+        QObject::disconnect(document, &QTextDocument::contentsChanged, document, nullptr);
+        this->connect_text_document(document);
+    }
+}
+
+Task::~Task() {
+    if (this->has_text_document) {
+        get_text_document_cache().take(this);
+    }
+}
+
 // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
 Task::Task(const QVariantList& args)
     : Task(
@@ -73,7 +197,7 @@ Task::Task(const QVariantList& args)
         args[3].toDateTime(),
         args[4].toDateTime(),
         args[5].toString(),
-        args[6].toString()
+        args[6].value<TaskId>().toString()
     ) {}
 // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
 
@@ -82,7 +206,38 @@ QString Task::get_title() const {
 }
 
 QTextDocument* Task::get_text_document() const {
-    return this->description.get();
+    // The documents and their cache are not synchronised and only ever touched by the GUI:
+    Q_ASSERT(
+        QCoreApplication::instance() == nullptr
+        || QThread::currentThread() == QCoreApplication::instance()->thread()
+    );
+    auto& cache = get_text_document_cache();
+    if (this->has_text_document) {
+        return cache.touch(this);
+    }
+
+    auto document = std::make_unique<QTextDocument>();
+    document->setHtml(this->description_html);
+    document->setModified(false);
+    this->connect_text_document(document.get());
+    this->has_text_document = true;
+
+    auto* result = document.get();
+    const auto least_recently_used = cache.insert(this, std::move(document));
+    if (least_recently_used.has_value()) {
+        least_recently_used->task->release_text_document(*least_recently_used->document);
+    }
+    return result;
+}
+
+/**
+ * @brief Keeps the unsaved changes of a document that the cache is about to destroy.
+ */
+void Task::release_text_document(const QTextDocument& document) const {
+    if (document.isModified()) {
+        this->description_html = document.toHtml();
+    }
+    this->has_text_document = false;
 }
 
 Task::Status Task::get_status() const {
@@ -105,8 +260,17 @@ QSet<TagId> Task::get_tags() const {
     return this->tags;
 }
 
+QString Task::get_search_text() const {
+    if (!this->search_text_valid) {
+        this->search_text = (this->title + '\n' + this->get_description_plain_text()).toCaseFolded();
+        this->search_text_valid = true;
+    }
+    return this->search_text;
+}
+
 void Task::set_title(const QString& new_title) {
     this->title = new_title;
+    this->search_text_valid = false;
 }
 
 void Task::set_status(Task::Status new_status) {
@@ -136,8 +300,10 @@ QVariant Task::get_data(int role) const {
     case StartRole:      return this->get_start_datetime();
     case DueRole:        return this->get_due_datetime();
     case ResolveRole:    return this->get_resolve_datetime();
-    case DetailsRole:    return this->get_text_document()->toPlainText();
+    case DetailsRole:    return this->get_description_plain_text();
+    case DocumentRole:   return QVariant::fromValue(QPointer<QTextDocument>(this->get_text_document()));
     case TagsRole:       return QVariant::fromValue(this->get_tags());
+    case SearchTextRole: return this->get_search_text();
     default:              return UniqueDataItem::get_data(role);
     }
 }
@@ -170,6 +336,39 @@ void Task::set_data(const QVariant& value, int role) {
     }
 }
 
+/**
+ * @brief Returns the description as HTML, including unsaved changes of an open document.
+ */
+QString Task::get_description_html() const {
+    const auto* document = this->has_text_document ? get_text_document_cache().find(this) : nullptr;
+    return document != nullptr && document->isModified()
+        ? document->toHtml()
+        : this->description_html;
+}
+
+QString Task::get_description_plain_text() const {
+    if (!this->description_plain_text_valid) {
+        const auto* document = this->has_text_document ? get_text_document_cache().find(this) : nullptr;
+        this->description_plain_text = document != nullptr
+            ? document->toPlainText()
+            : QTextDocumentFragment::fromHtml(this->description_html).toPlainText();
+        this->description_plain_text_valid = true;
+    }
+    return this->description_plain_text;
+}
+
+void Task::connect_text_document(QTextDocument* document) const {
+    QObject::connect(
+        document, &QTextDocument::contentsChanged,
+        document, [this]() { this->invalidate_text_projections(); }
+    );
+}
+
+void Task::invalidate_text_projections() const {
+    this->description_plain_text_valid = false;
+    this->search_text_valid = false;
+}
+
 QString Task::status_to_string(Task::Status status) {
     const char* enum_key = QMetaEnum::fromType<Status>().valueToKey(status);
     if (enum_key == nullptr) {
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -18,8 +18,6 @@
 
 #pragma once
 
-#include <memory>
-
 #include <QDateTime>
 #include <QObject>
 #include <QSet>
@@ -31,9 +29,16 @@
 #include "uniquedataitem.h"
 
 
-class Task : public QObject, public UniqueDataItem {
+/**
+ * @brief A task as a plain value type.
+ *
+ * Task is a gadget rather than a QObject: it only needs the meta object for its Status
+ * enum, and QObject would add a private object, thread affinity and a deleted copy
+ * constructor to every single task.
+ */
+class Task : public UniqueDataItem {
 
-    Q_OBJECT
+    Q_GADGET
 
 public:
 
@@ -53,19 +58,38 @@ public:
         , const QString& task_id       = ""
     );
     explicit Task(const QVariantList& args);
+    Task(const Task& other);
     Task(Task&& other) noexcept;
-    Task(Task& other) = delete;
-    Task& operator=(Task& other) = delete;
+    Task& operator=(const Task& other) = delete;
     Task& operator=(Task&& other) = delete;
-    ~Task() override = default;
+    ~Task() override;
+
+    /**
+     * @brief Maximum number of text documents kept in memory across all tasks.
+     */
+    static constexpr qsizetype max_open_text_documents = 32;
 
     [[nodiscard]] QString        get_title()            const;
+    /**
+     * @brief Creates the description document on first access.
+     *
+     * Once more than max_open_text_documents documents are open, the least
+     * recently accessed one is serialised back to HTML and destroyed. Callers
+     * holding on to the pointer should guard it with a QPointer, which is also
+     * what DocumentRole hands out. Must only be called from the GUI thread.
+     */
     [[nodiscard]] QTextDocument* get_text_document()    const;
     [[nodiscard]] Status         get_status()           const;
     [[nodiscard]] QDateTime      get_start_datetime()   const;
     [[nodiscard]] QDateTime      get_due_datetime()     const;
     [[nodiscard]] QDateTime      get_resolve_datetime() const;
     [[nodiscard]] QSet<TagId>    get_tags()             const;
+    /**
+     * @brief Case folded title and plain text description, used for searching.
+     *
+     * The text is cached until the title or the description document changes.
+     */
+    [[nodiscard]] QString        get_search_text()      const;
 
     void set_start_datetime  (const QDateTime&   start_datetime  );
     void set_status          (Status             new_status      );
@@ -80,11 +104,24 @@ public:
     static QString status_to_string(Status status);
 
 private:
-    QString                        title;
-    std::unique_ptr<QTextDocument> description;
-    Status                         status;
-    QDateTime                      start_date;
-    QDateTime                      due_date;
-    QDateTime                      resolve_date;
-    QSet<TagId>                    tags;
+    [[nodiscard]] QString get_description_plain_text() const;
+    [[nodiscard]] QString get_description_html() const;
+    void release_text_document(const QTextDocument& document) const;
+    void connect_text_document(QTextDocument* document) const;
+    void invalidate_text_projections() const;
+
+    // Ordered by alignment to avoid padding; the status and the flags fill the tail.
+    // The open text document is owned by the document cache, not by the task.
+    QString         title;
+    mutable QString description_html;
+    mutable QString description_plain_text;
+    mutable QString search_text;
+    QDateTime       start_date;
+    QDateTime       due_date;
+    QDateTime       resolve_date;
+    QSet<TagId>     tags;
+    Status          status;
+    mutable bool    has_text_document            : 1 = false;
+    mutable bool    description_plain_text_valid : 1 = false;
+    mutable bool    search_text_valid            : 1 = false;
 };
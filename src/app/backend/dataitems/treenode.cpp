@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -18,84 +18,72 @@
 
 #include "treenode.h"
 
-#include <memory>
-#include <stack>
-#include <tuple>
-#include <utility>
+#include <cstddef>
+#include <vector>
 
 #include <QVariant>
 
-#include "uniquedataitem.h"
+#include "graphnode.h"
+#include "utils/objectpool.h"
+
+TreeNode::TreeNode(
+    ObjectPool<TreeNode>* pool,
+    GraphNode* graph_node,
+    const TreeNode* parent,
+    int row_in_parent
+)
+    : pool(pool), graph_node(graph_node), parent(parent), row_in_parent(row_in_parent)
+{
+    this->graph_node->add_tree_node(this);
+}
 
-TreeNode::TreeNode(std::shared_ptr<UniqueDataItem> data, const TreeNode* parent)
-    : data(std::move(data)), parent(parent) {}
+TreeNode::~TreeNode() {
+    for (auto* child : this->children) {
+        this->pool->destroy(child);
+    }
+    this->graph_node->remove_tree_node(this);
+}
 
 /**
- * @brief Private wrapper for the constructor to avoid using new-operator at many places
+ * @brief Allocate a TreeNode from the given pool; it must be released using destroy.
  */
-std::unique_ptr<TreeNode> TreeNode::create(
-    std::shared_ptr<UniqueDataItem> data,
-    const TreeNode* parent
+TreeNode* TreeNode::create(
+    ObjectPool<TreeNode>& pool,
+    GraphNode* graph_node,
+    const TreeNode* parent,
+    int row_in_parent
 ) {
-    return std::unique_ptr<TreeNode>(new TreeNode(std::move(data), parent));
+    return pool.create(&pool, graph_node, parent, row_in_parent);
 }
 
 /**
- * @brief Create a new TreeNode with the given data item.
- *
- * Use this function, if no other TreeNode with the given data item exists.
- * @sa TreeNode::clone
+ * @brief Destroy a TreeNode and all of its children and return them to their pool.
  */
-std::unique_ptr<TreeNode> TreeNode::create(
-    std::unique_ptr<UniqueDataItem> data,
-    const TreeNode* parent
-) {
-    return std::unique_ptr<TreeNode>(new TreeNode(std::move(data), parent));
+void TreeNode::destroy(TreeNode* node) {
+    if (node != nullptr) {
+        node->pool->destroy(node);
+    }
 }
 
 /**
- * @brief Clone an existing TreeNode but use a different parent.
- *
- * Use this function, if the new and the provided TreeNode should be identical
- * except for the parent TreeNode. This can be used, to allow a TreeNode to
- * appear multiple times in the tree hierarchy.
- *
- * The parent pointer is stored in the clone, but not modified itself, that is
- * the clone is not added as a child to the parent. This is in the responsibility
- * of the calling function.
+ * @brief Reserve one (still empty) slot per child of the graph node.
  *
- * @sa TreeNode::create
+ * From now on, the number of children is fixed until it is changed explicitly by
+ * insert_children or remove_children, which apply the changes of the graph node at the
+ * same rows. Hence, an empty slot refers to the child of the graph node at the same row,
+ * skipping the rows that this TreeNode has removed ahead of the graph node.
  */
-std::unique_ptr<TreeNode> TreeNode::clone(
-    const TreeNode* to_be_cloned,
-    const TreeNode* parent
-) {
-    std::stack<std::pair<TreeNode*, TreeNode*>> to_be_cloned_stack;
-
-    const auto clone_node_and_queue_children
-        = [&to_be_cloned_stack](const TreeNode* original_node, const TreeNode* parent_node) {
-        auto clone = TreeNode::create(original_node->data, parent_node);
-        clone->children.reserve(original_node->children.size());
-        for (const auto& child : original_node->children) {
-            to_be_cloned_stack.emplace(child.get(), clone.get());
-        }
-        return clone;
-    };
-
-    auto result = clone_node_and_queue_children(to_be_cloned, parent);
-
-    TreeNode* original_node = nullptr;
-    TreeNode* new_parent_node = nullptr;
-
-    while (!to_be_cloned_stack.empty()) {
-        std::tie(original_node, new_parent_node) = to_be_cloned_stack.top();
-        to_be_cloned_stack.pop();
-
-        auto node_clone = clone_node_and_queue_children(original_node, new_parent_node);
-        new_parent_node->children.push_back(std::move(node_clone));
+void TreeNode::materialize_child_slots() const {
+    if (!this->children_materialized) {
+        this->children.resize(
+            this->graph_node->get_child_count() - this->removed_rows_ahead_of_graph
+        );
+        this->children_materialized = true;
     }
+}
 
-    return result;
+GraphNode* TreeNode::get_graph_node() const {
+    return this->graph_node;
 }
 
 const TreeNode* TreeNode::get_parent() const {
@@ -103,44 +91,80 @@ const TreeNode* TreeNode::get_parent() const {
 }
 
 TreeNode* TreeNode::get_child(int row) const {
-    return this->children.at(row).get();
+    this->materialize_child_slots();
+    auto& child = this->children.at(row);
+    if (child == nullptr) {
+        const auto graph_row = this->graph_node->get_remaining_child_row(
+            row, this->removed_rows_ahead_of_graph
+        );
+        child = TreeNode::create(*this->pool, this->graph_node->get_child(graph_row), this, row);
+    }
+    return child;
 }
 
-void TreeNode::add_child(std::unique_ptr<UniqueDataItem> child_data) {
-    auto new_child = TreeNode::create(std::move(child_data), this);
-    this->children.push_back(std::move(new_child));
+int TreeNode::get_child_count() const {
+    this->materialize_child_slots();
+    return static_cast<int>(this->children.size());
 }
 
-void TreeNode::add_child(std::unique_ptr<TreeNode> new_child) {
-    new_child->parent = this;
-    this->children.push_back(std::move(new_child));
+int TreeNode::get_row_in_parent() const {
+    return this->row_in_parent;
 }
 
-int TreeNode::get_child_count() const {
-    return static_cast<int>(this->children.size());
+/**
+ * @brief Renumber the existing children from the given row on after inserting or removing rows.
+ */
+void TreeNode::update_rows_of_children(int first_row) {
+    for (auto row=static_cast<std::size_t>(first_row); row<this->children.size(); row++) {
+        if (this->children[row] != nullptr) {
+            this->children[row]->row_in_parent = static_cast<int>(row);
+        }
+    }
 }
 
-void TreeNode::remove_children(int row, int count) {
-    auto it_first = this->children.begin() + row;
-    this->children.erase(it_first, it_first + count);
+/**
+ * @brief Add slots for children that have been inserted into the graph node at the given row.
+ */
+void TreeNode::insert_children(int row, int count) {
+    if (this->children_materialized) {
+        this->children.insert(this->children.begin() + row, static_cast<std::size_t>(count), nullptr);
+        this->update_rows_of_children(row + count);
+    }
 }
 
-int TreeNode::get_row_in_parent() const {
-    int result = 0;
-    for (const auto& child : this->parent->children) {
-        if (child.get() == this) {
-            return result;
+/**
+ * @brief Remove the slots of children that are about to be removed from the graph node.
+ *
+ * If the graph node has announced the removal (GraphNode::begin_child_removal), the rows
+ * are removed from the last to the first range and the remaining empty slots are mapped
+ * past them until end_child_removal is called. Otherwise, the graph node has to be
+ * updated before the TreeNode is accessed again.
+ */
+void TreeNode::remove_children(int row, int count) {
+    if (this->children_materialized) {
+        auto it_first = this->children.begin() + row;
+        for (auto it = it_first; it != it_first + count; ++it) {
+            this->pool->destroy(*it);
         }
-        result++;
+        this->children.erase(it_first, it_first + count);
+        this->update_rows_of_children(row);
+    }
+    if (this->graph_node->is_removing_children()) {
+        this->removed_rows_ahead_of_graph += count;
     }
-    return -1; // Should not happen
+}
+
+/**
+ * @brief Resume mapping empty slots to the same rows once the graph node has caught up.
+ */
+void TreeNode::end_child_removal() {
+    this->removed_rows_ahead_of_graph = 0;
 }
 
 QVariant TreeNode::get_data(int role) const {
-    return this->data->get_data(role);
+    return this->graph_node->get_data(role);
 }
 
 void TreeNode::set_data(const QVariant& value, int role) {
-    this->data->set_data(value, role);
+    this->graph_node->set_data(value, role);
 }
-
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -18,44 +18,75 @@
 
 #pragma once
 
-#include <memory>
 #include <vector>
 
 #include <QVariant>
 
-#include "uniquedataitem.h"
+#include "graphnode.h"
+#include "utils/objectpool.h"
 
+/**
+ * @brief A lightweight handle representing one path to a GraphNode in a tree.
+ *
+ * A GraphNode with several parents appears several times in the tree, once below every
+ * TreeNode of each of its parents. The TreeNodes are created lazily: the children of a
+ * TreeNode are only materialized when they are accessed. Thus, only the branches that
+ * have actually been visited, e.g. expanded in a view, exist as TreeNodes. Observers
+ * that need every item read the graph instead, see TreeItemModel.
+ *
+ * The children of a TreeNode mirror the children of its GraphNode. Structural changes
+ * of the graph have to be applied to its TreeNodes using insert_children and
+ * remove_children, see TreeItemModel. Children are inserted into the graph first and
+ * removed from the TreeNodes first.
+ *
+ * All TreeNodes of a tree are allocated from the same pool; a TreeNode destroys its
+ * children when it is destroyed itself.
+ */
 class TreeNode {
 
 private:
-    std::shared_ptr<UniqueDataItem> data;
+    ObjectPool<TreeNode>* pool;
+    GraphNode* graph_node;
     const TreeNode* parent;
-    std::vector<std::unique_ptr<TreeNode>> children;
+    int row_in_parent;
+    int removed_rows_ahead_of_graph = 0; // See remove_children
+    mutable std::vector<TreeNode*> children;
+    mutable bool children_materialized = false;
 
-    TreeNode(std::shared_ptr<UniqueDataItem> data, const TreeNode* parent);
-    static std::unique_ptr<TreeNode> create(
-        std::shared_ptr<UniqueDataItem> data,
-        const TreeNode* parent
+    friend class ObjectPool<TreeNode>;
+
+    TreeNode(
+        ObjectPool<TreeNode>* pool,
+        GraphNode* graph_node,
+        const TreeNode* parent,
+        int row_in_parent
     );
+    ~TreeNode();
+    void update_rows_of_children(int first_row);
 
 public:
-    static std::unique_ptr<TreeNode> create(
-        std::unique_ptr<UniqueDataItem> data,
-        const TreeNode* parent = nullptr
-    );
-    static std::unique_ptr<TreeNode> clone(
-        const TreeNode* to_be_cloned,
-        const TreeNode* parent = nullptr
+    static TreeNode* create(
+        ObjectPool<TreeNode>& pool,
+        GraphNode* graph_node,
+        const TreeNode* parent = nullptr,
+        int row_in_parent = 0
     );
+    TreeNode(const TreeNode&)            = delete;
+    TreeNode(TreeNode&&)                 = delete;
+    TreeNode& operator=(const TreeNode&) = delete;
+    TreeNode& operator=(TreeNode&&)      = delete;
+    static void destroy(TreeNode* node);
 
+    [[nodiscard]] GraphNode* get_graph_node() const;
     [[nodiscard]] const TreeNode* get_parent() const;
     [[nodiscard]] TreeNode* get_child(int row) const;
-    void add_child(std::unique_ptr<UniqueDataItem> child_data);
-    void add_child(std::unique_ptr<TreeNode> new_child);
     [[nodiscard]] int get_child_count() const;
+    [[nodiscard]] int get_row_in_parent() const;
 
+    void materialize_child_slots() const;
+    void insert_children(int row, int count);
     void remove_children(int row, int count);
-    [[nodiscard]] int get_row_in_parent() const;
+    void end_child_removal();
 
     [[nodiscard]] QVariant get_data(int role) const;
     void set_data(const QVariant& value, int role);
@@ -19,16 +19,26 @@
 #include "filteredtaskitemmodel.h"
 
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory>
+#include <optional>
+#include <stack>
 #include <utility>
+#include <vector>
 
 #include <QAbstractProxyModel>
+#include <QHash>
+#include <QList>
 #include <QRegularExpression>
+#include <QSet>
 
+#include "dataitems/graphnode.h"
 #include "dataitems/qtdid.h"
 #include "dataitems/qtditemdatarole.h"
-#include "dataitems/treenode.h"
-#include "utils/modeliteration.h"
+#include "tagnumbering.h"
+#include "treeitemmodel.h"
+#include "utils/densebitset.h"
 
 /**
  * @class FilteredTaskItemModel
@@ -37,16 +47,49 @@
  * A given search string filters matching tasks and emits a signal with the tags of
  * the filtered tasks. Tasks can also be filtered by a set of selected tasks, leaving
  * the set of emitted tags unaltered.
+ *
+ * The source model has to be a TreeItemModel. The filtered tree is derived from its
+ * graph: the children of a row are the closest descendants that are shown, every task
+ * at most once per parent. Rows are mapped lazily when a view requests them, so that
+ * no tree nodes of the source are created for hidden tasks, and only rows that have been
+ * mapped are updated when the graph changes. For that purpose, every row remembers the
+ * source items it visited while its children were determined; a change of one of them
+ * re-evaluates the children of the row, inserting and removing rows without resetting
+ * the model. Data changes are only re-evaluated if a role the filters depend on changed,
+ * see set_filter_roles.
+ *
+ * If a TaskSearchIndex of the source model is set, the search words are only evaluated
+ * for the candidate tasks found by the index. Likewise, if a TaskColumnStore and a
+ * matching column filter are set, the status of all tasks is evaluated at once on the
+ * columns of the store instead of calling the filter function for each task.
+ *
+ * Tags are handled as bitsets over dense tag numbers, so that the tag selection and the
+ * remaining tags are evaluated word by word. The tag sets are taken from the column store
+ * if one is set. The QSet<TagId> based interface is kept for QML.
  */
 
 namespace {
-    bool task_index_contains_word(const QModelIndex &index, const QString &word) {
-        return index.data(Qt::DisplayRole).toString().contains(word, Qt::CaseInsensitive)
-               || index.data(DetailsRole).toString().contains(word, Qt::CaseInsensitive);
+    // The roles the search string and the tag selection depend on:
+    const QList<int> search_roles = {Qt::DisplayRole, DetailsRole, SearchTextRole};
+    const QList<int> tag_roles = {TagsRole, AddTagRole, RemoveTagRole};
+
+    /**
+     * @brief Check whether a change of the given roles may affect a result depending on
+     *        the relevant roles; an empty list of changed roles stands for all roles.
+     */
+    bool depends_on_roles(const QList<int>& changed_roles, const QList<int>& relevant_roles) {
+        return changed_roles.isEmpty() || std::ranges::any_of(
+            changed_roles,
+            [&relevant_roles](int role) { return relevant_roles.contains(role); }
+        );
     }
 
-    TaskId get_uuid(const QModelIndex &index) {
-        return index.isValid() ? index.data(UuidRole).value<TaskId>() : TaskId();
+    int get_depth(const auto* mapping_node) {
+        int depth = 0;
+        for (; mapping_node->parent != nullptr; mapping_node = mapping_node->parent) {
+            depth++;
+        }
+        return depth;
     }
 } // anonymous namespace
 
@@ -63,74 +106,113 @@ FilteredTaskItemModel::FilteredTaskItemModel(
 
 void FilteredTaskItemModel::setup_signal_slot_connections() {
     connect(
-        this->sourceModel(), &QAbstractItemModel::dataChanged,
-        this, &FilteredTaskItemModel::source_data_changed
-    );
-    connect(
-        this->sourceModel(), &QAbstractItemModel::rowsAboutToBeRemoved,
-        this, &FilteredTaskItemModel::beginResetModel
-    );
-    connect(
-        this->sourceModel(), &QAbstractItemModel::rowsRemoved,
-        this, &FilteredTaskItemModel::source_model_changed
+        this->tree_model, &TreeItemModel::item_created,
+        this, &FilteredTaskItemModel::source_item_created
     );
     connect(
-        this->sourceModel(), &QAbstractItemModel::rowsAboutToBeInserted,
-        this, &FilteredTaskItemModel::beginResetModel
+        this->tree_model, &TreeItemModel::items_destroyed,
+        this, &FilteredTaskItemModel::source_items_destroyed
     );
     connect(
-        this->sourceModel(), &QAbstractItemModel::rowsInserted,
-        this, &FilteredTaskItemModel::source_model_changed
+        this->tree_model, &TreeItemModel::item_changed,
+        this, &FilteredTaskItemModel::source_item_changed
     );
     connect(
-        this->sourceModel(), &QAbstractItemModel::rowsAboutToBeMoved,
-        this, &FilteredTaskItemModel::beginResetModel
+        this->tree_model, &TreeItemModel::relation_added,
+        this, &FilteredTaskItemModel::source_relation_added
     );
     connect(
-        this->sourceModel(), &QAbstractItemModel::rowsMoved,
-        this, &FilteredTaskItemModel::source_model_changed
+        this->tree_model, &TreeItemModel::relations_removed,
+        this, &FilteredTaskItemModel::source_relations_removed
     );
     connect(
-        this->sourceModel(), &QAbstractItemModel::layoutAboutToBeChanged,
+        this->tree_model, &QAbstractItemModel::modelAboutToBeReset,
         this, &FilteredTaskItemModel::beginResetModel
     );
     connect(
-        this->sourceModel(), &QAbstractItemModel::layoutChanged,
-        this, &FilteredTaskItemModel::source_model_changed
-    );
-    connect(
-        this->sourceModel(), &QAbstractItemModel::modelAboutToBeReset,
-        this, &FilteredTaskItemModel::beginResetModel
-    );
-    connect(
-        this->sourceModel(), &QAbstractItemModel::modelReset,
+        this->tree_model, &QAbstractItemModel::modelReset,
         this, &FilteredTaskItemModel::source_model_changed
     );
 }
 
+/**
+ * @brief Set the source model, which has to be a TreeItemModel; other models appear empty.
+ */
 void FilteredTaskItemModel::setSourceModel(QAbstractItemModel *sourceModel) {
     this->beginResetModel();
-    if (this->sourceModel() != nullptr) {
-        this->sourceModel()->disconnect(this);
+    if (this->tree_model != nullptr) {
+        this->tree_model->disconnect(this);
     }
     QAbstractProxyModel::setSourceModel(sourceModel);
-    this->setup_signal_slot_connections();
-    this->rebuild_index_mapping();
+    this->tree_model = qobject_cast<const TreeItemModel*>(sourceModel);
+    this->search_candidates_outdated = true;
+    this->status_mask_outdated = true;
+    this->selected_tag_bitset_outdated = true;
+    this->reset_mapping();
+    if (this->tree_model != nullptr) {
+        this->setup_signal_slot_connections();
+        this->rebuild_matches();
+    }
+    this->endResetModel();
+}
+
+/**
+ * @brief Use a search index of the source model to narrow down search results.
+ *
+ * The index must have been connected to the source model before this proxy model,
+ * see TaskSearchIndex.
+ */
+void FilteredTaskItemModel::set_search_index(const TaskSearchIndex* search_index) {
+    this->search_index = search_index;
+    this->search_candidates_outdated = true;
+}
+
+/**
+ * @brief Evaluate the status of the tasks on the columns of a store of the source model.
+ *
+ * The filter has to be equivalent to the filter function of this model, which is still
+ * used for tasks unknown to the store. Like the search index, the store must have been
+ * connected to the source model before this proxy model, see TaskColumnStore.
+ */
+void FilteredTaskItemModel::set_column_filter(
+    const TaskColumnStore* column_store,
+    TaskColumnStore::Filter filter
+) {
+    // The stored tag bitsets become invalid if the tag numbering changes:
+    this->beginResetModel();
+    this->reset_mapping();
+    this->column_store = column_store;
+    this->column_filter = filter;
+    this->status_mask_outdated = true;
+    this->selected_tag_bitset_outdated = true;
+    this->rebuild_matches();
     this->endResetModel();
 }
 
+/**
+ * @brief Declare the roles the filter function depends on.
+ *
+ * Data changes of other roles are forwarded without evaluating the filter function
+ * again. Without this declaration, the filter function is assumed to depend on all roles.
+ */
+void FilteredTaskItemModel::set_filter_roles(const QList<int>& roles) {
+    this->filter_roles = roles;
+}
+
 void FilteredTaskItemModel::set_search_string(const QString &search_string) {
     this->beginResetModel();
+    this->search_candidates_outdated = true;
 
     this->filter_words.clear();
     auto match_iterator = this->split_regex.globalMatch(search_string);
 
     while (match_iterator.hasNext()) {
         auto match = match_iterator.next();
-        this->filter_words << match.captured(match.lastCapturedIndex());
+        this->filter_words << match.captured(match.lastCapturedIndex()).toCaseFolded();
     }
 
-    this->rebuild_index_mapping();
+    this->reset_mapping();
+    this->rebuild_matches();
     this->endResetModel();
 }
 
@@ -141,141 +223,722 @@ void FilteredTaskItemModel::clear_search_string() {
 void FilteredTaskItemModel::set_selected_tags(const QSet<TagId> &tags) {
     this->beginResetModel();
     this->selected_tags = tags;
-    this->rebuild_index_mapping();
+    this->selected_tag_bitset_outdated = true;
+    this->reset_mapping();
     this->endResetModel();
 }
 
 
-bool FilteredTaskItemModel::index_matches_search_string(const QModelIndex &index) const {
+/**
+ * @brief Tasks that may match the search string according to the search index.
+ *
+ * std::nullopt means that every task has to be checked, e.g. because no search
+ * index is set. The candidates are determined lazily after the search string or
+ * the whole source model changed, see update_search_candidate for single tasks.
+ */
+const std::optional<QSet<TaskId>>& FilteredTaskItemModel::get_search_candidates() const {
+    if (this->search_candidates_outdated) {
+        this->search_candidates = (this->search_index != nullptr && !this->filter_words.isEmpty())
+            ? this->search_index->find_candidates(this->filter_words)
+            : std::nullopt;
+        this->search_candidates_outdated = false;
+    }
+    return this->search_candidates;
+}
+
+/**
+ * @brief Add or remove a created, changed or destroyed task to or from the search candidates.
+ *
+ * The task itself is checked against the search words, so the candidates stay a superset
+ * of the matching tasks without querying the search index again.
+ */
+void FilteredTaskItemModel::update_search_candidate(const TaskId& task) {
+    if (this->search_candidates_outdated || !this->search_candidates.has_value()) {
+        return;
+    }
+    const auto* graph_node = this->tree_model->find_graph_node(task);
+    if (graph_node != nullptr && this->matches_filter_words(*graph_node)) {
+        this->search_candidates->insert(task);
+    } else {
+        this->search_candidates->remove(task);
+    }
+}
+
+/**
+ * @brief One byte per task number of the column store; non-zero if the status matches.
+ *
+ * The mask is determined lazily after the filter or the whole source model changed;
+ * changes of single tasks only update their entries, see update_status_mask.
+ */
+const std::vector<quint8>& FilteredTaskItemModel::get_status_mask() const {
+    if (this->status_mask_outdated) {
+        this->status_mask = this->column_store->get_status_mask(this->column_filter->status);
+        this->status_mask_outdated = false;
+    }
+    return this->status_mask;
+}
+
+/**
+ * @brief Update the entry of a created or changed task in the status mask.
+ *
+ * Destroyed tasks need no update: their numbers are unknown to the store until they
+ * are reused for a created task.
+ */
+void FilteredTaskItemModel::update_status_mask(const TaskId& task) {
+    if (this->status_mask_outdated || this->column_store == nullptr || !this->column_filter.has_value()) {
+        return;
+    }
+    const auto number = this->column_store->get_number(task);
+    if (number == TaskColumnStore::unknown_number) {
+        return;
+    }
+    const auto statuses = this->column_store->get_statuses();
+    if (this->status_mask.size() < statuses.size()) {
+        this->status_mask.resize(statuses.size());
+    }
+    this->status_mask[number] = static_cast<quint8>(statuses[number] == this->column_filter->status);
+}
+
+bool FilteredTaskItemModel::is_accepted(const GraphNode& task, const GraphNode& top_level_task) const {
+    if (this->column_store == nullptr || !this->column_filter.has_value()) {
+        return this->is_task_accepted(task, top_level_task);
+    }
+
+    const auto* evaluated_task = &task;
+    switch (this->column_filter->scope) {
+        case TaskColumnStore::Filter::Scope::task:
+            break;
+        case TaskColumnStore::Filter::Scope::leaf_task:
+            if (task.get_child_count() > 0) {
+                return false;
+            }
+            break;
+        case TaskColumnStore::Filter::Scope::top_level_ancestor:
+            evaluated_task = &top_level_task;
+            break;
+    }
+
+    const auto& mask = this->get_status_mask();
+    const auto number = this->column_store->get_number(evaluated_task->get_uuid());
+    if (number == TaskColumnStore::unknown_number || number >= std::ssize(mask)) {
+        return this->is_task_accepted(task, top_level_task);
+    }
+    return mask[number] != 0;
+}
+
+bool FilteredTaskItemModel::task_matches_search_string(const GraphNode& task) const {
+    const auto& candidates = this->get_search_candidates();
+    if (candidates.has_value() && !candidates->contains(task.get_uuid())) {
+        return false;
+    }
+    return this->matches_filter_words(task);
+}
+
+bool FilteredTaskItemModel::matches_filter_words(const GraphNode& task) const {
+    if (this->filter_words.isEmpty()) {
+        return true;
+    }
+    const auto search_text = task.get_data(SearchTextRole).toString();
     return std::ranges::all_of(
         this->filter_words,
-        [&index](const QString &word) {
-            return task_index_contains_word(index, word);
+        [&search_text](const QString &word) {
+            return search_text.contains(word);
         }
     );
 }
 
-bool FilteredTaskItemModel::index_matches_tag_selection(const QModelIndex &index) const {
-    if (this->selected_tags.isEmpty()) {
-        return true;
+const TagNumbering& FilteredTaskItemModel::get_tag_numbering() const {
+    return (this->column_store != nullptr) ? this->column_store->get_tag_numbering() : this->own_tag_numbering;
+}
+
+/**
+ * @brief The tags of a task as a bitset over the numbering of get_tag_numbering.
+ */
+DenseBitset FilteredTaskItemModel::get_tag_bitset(const GraphNode& task) const {
+    if (this->column_store == nullptr) {
+        return this->own_tag_numbering.assign_bitset(task.get_data(TagsRole).value<QSet<TagId>>());
+    }
+    const auto number = this->column_store->get_number(task.get_uuid());
+    if (number == TaskColumnStore::unknown_number) {
+        return this->column_store->get_tag_numbering().to_bitset(task.get_data(TagsRole).value<QSet<TagId>>());
     }
-    auto index_tags = index.data(TagsRole).value<QSet<TagId> >();
-    return index_tags.intersects((this->selected_tags));
+    return this->column_store->get_tag_sets()[number];
 }
 
-QModelIndex FilteredTaskItemModel::find_proxy_parent(const QModelIndex &source_index) const {
-    auto source_parent_index = source_index.parent();
-    while (source_parent_index.isValid()) {
-        auto proxy_parent_index = this->mapFromSource(source_parent_index);
-        if (proxy_parent_index.isValid()) {
-            return proxy_parent_index;
-        }
-        source_parent_index = source_parent_index.parent();
+/**
+ * @brief The selected tags as a bitset; determined lazily since tags may be numbered later.
+ */
+const DenseBitset& FilteredTaskItemModel::get_selected_tag_bitset() const {
+    if (this->selected_tag_bitset_outdated) {
+        this->selected_tag_bitset = (this->column_store != nullptr)
+            ? this->column_store->get_tag_numbering().to_bitset(this->selected_tags)
+            : this->own_tag_numbering.assign_bitset(this->selected_tags);
+        this->selected_tag_bitset_outdated = false;
     }
-    return {};
+    return this->selected_tag_bitset;
+}
+
+bool FilteredTaskItemModel::tags_match_tag_selection(const DenseBitset& tags) const {
+    return this->selected_tags.isEmpty() || tags.intersects(this->get_selected_tag_bitset());
+}
+
+bool FilteredTaskItemModel::is_shown(const GraphNode& task, const GraphNode& top_level_task) const {
+    return this->task_matches_search_string(task)
+           && this->is_accepted(task, top_level_task)
+           && this->tags_match_tag_selection(this->get_tag_bitset(task));
+}
+
+bool FilteredTaskItemModel::is_top_level_task(const GraphNode& task) const {
+    return std::ranges::find(task.get_parents(), this->tree_model->find_graph_node(TaskId()))
+           != task.get_parents().end();
 }
 
-bool FilteredTaskItemModel::is_child(const TaskId& child, const QModelIndex& parent) const {
-    auto [begin , end] = this->proxy_children.equal_range(parent);
-    while (begin != end) {
-        if (begin->data(UuidRole).value<TaskId>() == child) {
-            return true;
+/**
+ * @brief Check whether a task matches the search string and is accepted below at least
+ *        one of the top level tasks it descends from, regardless of the tag selection.
+ */
+bool FilteredTaskItemModel::is_match(const GraphNode& task) const {
+    if (!this->task_matches_search_string(task)) {
+        return false;
+    }
+
+    const auto* root = this->tree_model->find_graph_node(TaskId());
+    QSet<const GraphNode*> visited{&task};
+    std::stack<const GraphNode*> to_be_visited;
+    to_be_visited.push(&task);
+    while (!to_be_visited.empty()) {
+        const auto* current_node = to_be_visited.top();
+        to_be_visited.pop();
+        for (const auto* parent : current_node->get_parents()) {
+            if (parent == root) {
+                if (this->is_accepted(task, *current_node)) {
+                    return true;
+                }
+            } else if (!visited.contains(parent)) {
+                visited.insert(parent);
+                to_be_visited.push(parent);
+            }
         }
-        ++begin;
     }
     return false;
 }
 
-void FilteredTaskItemModel::reset_mapping() {
-    this->index_mapping.clear();
-    this->proxy_children.clear();
-    this->remaining_tags.clear();
+FilteredTaskItemModel::MappingNode* FilteredTaskItemModel::get_mapping_node(
+    const QModelIndex& proxy_index
+) const {
+    return proxy_index.isValid()
+        ? static_cast<MappingNode*>(proxy_index.internalPointer())
+        : &this->mapping_root;
 }
 
-void FilteredTaskItemModel::map_index(const QModelIndex& source_index) {
-    if (
-        !this->is_task_accepted(source_index) ||
-        !index_matches_search_string(source_index)
-    ) {
+QModelIndex FilteredTaskItemModel::create_proxy_index(const MappingNode* mapping_node) const {
+    if (mapping_node == &this->mapping_root) {
+        return {};
+    }
+    return this->createIndex(mapping_node->row, 0, mapping_node);
+}
+
+/**
+ * @brief Update the stored row of all children of a mapping node starting at first_row.
+ */
+void FilteredTaskItemModel::update_rows(MappingNode* parent, int first_row) {
+    for (auto row=first_row; row<static_cast<int>(parent->children.size()); row++) {
+        parent->children[row]->row = row;
+    }
+}
+
+void FilteredTaskItemModel::add_match(const TaskId& task, const DenseBitset& tags) {
+    this->matching_tasks.insert(task, tags);
+    tags.for_each([this](qsizetype tag) {
+        if (tag >= std::ssize(this->remaining_tag_count)) {
+            this->remaining_tag_count.resize(tag + 1, 0);
+        }
+        if (++this->remaining_tag_count[tag] == 1) {
+            this->remaining_tags_changed = true;
+        }
+    });
+}
+
+void FilteredTaskItemModel::remove_match(const TaskId& task) {
+    const auto match = this->matching_tasks.constFind(task);
+    if (match == this->matching_tasks.constEnd()) {
         return;
     }
 
-    this->remaining_tags.unite(
-        source_index.data(TagsRole).value<QSet<TagId> >()
-    );
-    if (!index_matches_tag_selection(source_index)) {
+    match->for_each([this](qsizetype tag) {
+        if (--this->remaining_tag_count[tag] == 0) {
+            this->remaining_tags_changed = true;
+        }
+    });
+    this->matching_tasks.erase(match);
+}
+
+/**
+ * @brief Evaluate a task again and update its stored match and tags.
+ */
+void FilteredTaskItemModel::update_match(const TaskId& task) {
+    const auto* graph_node = task.is_valid() ? this->tree_model->find_graph_node(task) : nullptr;
+    if (graph_node == nullptr || !this->is_match(*graph_node)) {
+        this->remove_match(task);
+        return;
+    }
+
+    const auto tags = this->get_tag_bitset(*graph_node);
+    const auto stored_match = this->matching_tasks.constFind(task);
+    if (stored_match != this->matching_tasks.constEnd() && *stored_match == tags) {
         return;
     }
+    this->remove_match(task);
+    this->add_match(task, tags);
+}
 
-    const auto proxy_parent = this->find_proxy_parent(source_index);
-    if (this->is_child(source_index.data(UuidRole).value<TaskId>(), proxy_parent)) {
+/**
+ * @brief Evaluate a task and all of its descendants again, e.g. since their top level
+ *        tasks changed.
+ */
+void FilteredTaskItemModel::update_matches_of_subtree(const TaskId& task) {
+    const auto* graph_node = this->tree_model->find_graph_node(task);
+    if (graph_node == nullptr) {
         return;
     }
 
-    const auto proxy_index = this->createIndex(
-        this->rowCount(proxy_parent), 0, source_index.internalPointer()
-    );
-    this->index_mapping.insert(
-        get_uuid(source_index),
-        std::make_pair(source_index, proxy_index)
-    );
-    this->proxy_children.insert(proxy_parent, proxy_index);
+    QSet<const GraphNode*> visited{graph_node};
+    std::stack<const GraphNode*> to_be_visited;
+    to_be_visited.push(graph_node);
+    while (!to_be_visited.empty()) {
+        const auto* current_node = to_be_visited.top();
+        to_be_visited.pop();
+        this->update_match(current_node->get_uuid());
+        for (int row=0; row<current_node->get_child_count(); row++) {
+            const auto* child = current_node->get_child(row);
+            if (!visited.contains(child)) {
+                visited.insert(child);
+                to_be_visited.push(child);
+            }
+        }
+    }
 }
 
-void FilteredTaskItemModel::rebuild_index_mapping() {
-    auto old_remaining_tags = this->remaining_tags;
-    this->reset_mapping();
-    ModelIteration::model_foreach(
-        *this->sourceModel(),
-        [this](const QModelIndex &source_index) {
-            this->map_index(source_index);
+QSet<TagId> FilteredTaskItemModel::get_remaining_tags() const {
+    DenseBitset tags;
+    for (qsizetype tag=0; tag<std::ssize(this->remaining_tag_count); tag++) {
+        if (this->remaining_tag_count[tag] > 0) {
+            tags.set(tag);
         }
-    );
-    if (old_remaining_tags != this->remaining_tags) {
-        emit this->filtered_tags_changed(this->remaining_tags);
     }
+    return this->get_tag_numbering().to_set(tags);
 }
 
-QModelIndex FilteredTaskItemModel::mapFromSource(const QModelIndex &sourceIndex) const {
-    if (sourceIndex.isValid()) {
-        auto iterator = this->index_mapping.constKeyValueBegin();
-        while (iterator != this->index_mapping.constKeyValueEnd()) {
-            if (iterator->second.first == sourceIndex) {
-                return iterator->second.second;
+void FilteredTaskItemModel::emit_remaining_tags_if_changed() {
+    if (this->remaining_tags_changed) {
+        this->remaining_tags_changed = false;
+        emit this->filtered_tags_changed(this->get_remaining_tags());
+    }
+}
+
+/**
+ * @brief Drop all mapping nodes; they are mapped again when views request them.
+ *
+ * Attached views are not notified; callers have to wrap this into a model reset.
+ */
+void FilteredTaskItemModel::reset_mapping() {
+    this->mapping_root.children.clear();
+    this->mapping_root.children_by_uuid.clear();
+    this->mapping_root.visited_items.clear();
+    this->mapping_root.children_mapped = false;
+    this->mapping_nodes.clear();
+    this->visitors.clear();
+    this->outdated_nodes.clear();
+}
+
+/**
+ * @brief Determine the matching tasks and emit their tags if they changed.
+ *
+ * Unlike the rows, the matches are kept for the whole graph: the descendants of every
+ * top level task are evaluated below it, every task only until it matches once.
+ */
+void FilteredTaskItemModel::rebuild_matches() {
+    const auto old_remaining_tags = this->get_remaining_tags();
+    this->matching_tasks.clear();
+    this->remaining_tag_count.clear();
+
+    const auto* root = (this->tree_model != nullptr) ? this->tree_model->find_graph_node(TaskId()) : nullptr;
+    for (int top_level_row=0; root != nullptr && top_level_row<root->get_child_count(); top_level_row++) {
+        const auto* top_level_task = root->get_child(top_level_row);
+        QSet<const GraphNode*> visited{top_level_task};
+        std::stack<const GraphNode*> to_be_visited;
+        to_be_visited.push(top_level_task);
+        while (!to_be_visited.empty()) {
+            const auto* current_node = to_be_visited.top();
+            to_be_visited.pop();
+            const auto uuid = current_node->get_uuid();
+            if (
+                !this->matching_tasks.contains(uuid)
+                && this->task_matches_search_string(*current_node)
+                && this->is_accepted(*current_node, *top_level_task)
+            ) {
+                this->add_match(uuid, this->get_tag_bitset(*current_node));
+            }
+            for (int row=0; row<current_node->get_child_count(); row++) {
+                const auto* child = current_node->get_child(row);
+                if (!visited.contains(child)) {
+                    visited.insert(child);
+                    to_be_visited.push(child);
+                }
             }
-            ++iterator;
         }
-        return {};
     }
-    return {};
+    this->remaining_tags_changed = (old_remaining_tags != this->get_remaining_tags());
+    this->emit_remaining_tags_if_changed();
 }
 
-QModelIndex FilteredTaskItemModel::mapToSource(const QModelIndex &proxyIndex) const {
-    if (proxyIndex.isValid()) {
-        auto iterator = this->index_mapping.constKeyValueBegin();
-        while (iterator != this->index_mapping.constKeyValueEnd()) {
-            if (iterator->second.second == proxyIndex) {
-                return iterator->second.first;
+/**
+ * @brief Find the source items to show as children of a mapping node.
+ *
+ * The source graph is traversed depth first from the item of the mapping node, descending
+ * only into items that are not shown. Every shown item is taken once; later clones would
+ * become siblings of the first one and are skipped. A hidden item is expanded only once
+ * per top level task, since its shown descendants would be skipped the second time.
+ *
+ * @param mapping_node the node whose children are determined
+ * @param visited_items receives the ids of all visited source items, the item of the node included
+ */
+std::vector<FilteredTaskItemModel::Candidate> FilteredTaskItemModel::find_children(
+    const MappingNode* mapping_node,
+    QSet<TaskId>& visited_items
+) const {
+    std::vector<Candidate> result;
+    visited_items.insert(mapping_node->uuid);
+    const auto* graph_node = (this->tree_model != nullptr) ? this->tree_model->find_graph_node(mapping_node->uuid) : nullptr;
+    if (graph_node == nullptr) {
+        return result;
+    }
+
+    struct Frame {
+        const GraphNode* graph_node;
+        int next_row;
+    };
+    std::vector<Frame> frames{{graph_node, 0}};
+    QSet<TaskId> shown_items;
+    QSet<std::pair<const GraphNode*, const GraphNode*>> expanded_items;
+    const auto* top_level_task = this->tree_model->find_graph_node(mapping_node->top_level_uuid);
+    const bool is_root = (mapping_node == &this->mapping_root);
+    if (top_level_task == nullptr) {
+        return result;
+    }
+
+    while (!frames.empty()) {
+        auto& frame = frames.back();
+        if (frame.next_row == frame.graph_node->get_child_count()) {
+            frames.pop_back();
+            continue;
+        }
+        const auto* child = frame.graph_node->get_child(frame.next_row++);
+        const auto uuid = child->get_uuid();
+        visited_items.insert(uuid);
+        if (is_root) {
+            top_level_task = (frames.size() == 1) ? child : frames[1].graph_node;
+        }
+
+        if (this->is_shown(*child, *top_level_task)) {
+            if (!shown_items.contains(uuid)) {
+                shown_items.insert(uuid);
+                QList<TaskId> hidden_path;
+                for (auto hidden_frame = frames.begin() + 1; hidden_frame != frames.end(); ++hidden_frame) {
+                    hidden_path.append(hidden_frame->graph_node->get_uuid());
+                }
+                result.push_back({uuid, top_level_task->get_uuid(), std::move(hidden_path)});
             }
-            ++iterator;
+        } else if (!expanded_items.contains({child, top_level_task})) {
+            expanded_items.insert({child, top_level_task});
+            frames.push_back({child, 0});
         }
+    }
+    return result;
+}
+
+void FilteredTaskItemModel::register_visitor(MappingNode* mapping_node) const {
+    for (const auto& item : std::as_const(mapping_node->visited_items)) {
+        this->visitors.insert(item, mapping_node);
+    }
+}
+
+void FilteredTaskItemModel::unregister_visitor(MappingNode* mapping_node) const {
+    for (const auto& item : std::as_const(mapping_node->visited_items)) {
+        this->visitors.remove(item, mapping_node);
+    }
+}
+
+/**
+ * @brief Create the children of a mapping node unless they exist already.
+ *
+ * Views are not notified; the rows are only mapped once they are requested.
+ */
+void FilteredTaskItemModel::map_children(MappingNode* mapping_node) const {
+    if (mapping_node->children_mapped) {
+        return;
+    }
+
+    mapping_node->children_mapped = true;
+    for (auto& candidate : this->find_children(mapping_node, mapping_node->visited_items)) {
+        auto child = std::make_unique<MappingNode>(
+            candidate.uuid,
+            candidate.top_level_uuid,
+            std::move(candidate.hidden_path),
+            mapping_node
+        );
+        child->row = static_cast<int>(mapping_node->children.size());
+        this->mapping_nodes.insert(child->uuid, child.get());
+        mapping_node->children_by_uuid.insert(child->uuid, child.get());
+        mapping_node->children.push_back(std::move(child));
+    }
+    this->register_visitor(mapping_node);
+}
+
+/**
+ * @brief Forget a mapping node and all of its descendants before they are removed.
+ */
+void FilteredTaskItemModel::unregister_subtree(MappingNode* mapping_node) {
+    std::stack<MappingNode*> to_be_visited;
+    to_be_visited.push(mapping_node);
+    while (!to_be_visited.empty()) {
+        auto* current_node = to_be_visited.top();
+        to_be_visited.pop();
+        this->unregister_visitor(current_node);
+        this->mapping_nodes.remove(current_node->uuid, current_node);
+        this->outdated_nodes.remove(current_node);
+        for (const auto& child : current_node->children) {
+            to_be_visited.push(child.get());
+        }
+    }
+}
+
+/**
+ * @brief Mark the mapped rows whose children depend on the data or the children of a task.
+ */
+void FilteredTaskItemModel::mark_visitors_outdated(const TaskId& task) {
+    for (auto* mapping_node : this->visitors.values(task)) {
+        this->outdated_nodes.insert(mapping_node);
+    }
+}
+
+/**
+ * @brief Mark the mapped rows below a top level task, since the filter function may
+ *        depend on the top level task of every row.
+ */
+void FilteredTaskItemModel::mark_top_level_task_outdated(const TaskId& top_level_task) {
+    for (auto* mapping_node : std::as_const(this->mapping_nodes)) {
+        if (mapping_node->children_mapped && mapping_node->top_level_uuid == top_level_task) {
+            this->outdated_nodes.insert(mapping_node);
+        }
+    }
+}
+
+/**
+ * @brief Determine the children of all outdated mapping nodes again, parents first.
+ *
+ * Updating a parent may remove outdated descendants or mark its children outdated.
+ */
+void FilteredTaskItemModel::update_outdated_nodes() {
+    while (!this->outdated_nodes.isEmpty()) {
+        MappingNode* mapping_node = nullptr;
+        int min_depth = 0;
+        for (auto* outdated_node : std::as_const(this->outdated_nodes)) {
+            const auto depth = get_depth(outdated_node);
+            if (mapping_node == nullptr || depth < min_depth) {
+                mapping_node = outdated_node;
+                min_depth = depth;
+            }
+        }
+        this->outdated_nodes.remove(mapping_node);
+        this->update_children(mapping_node);
+    }
+}
+
+/**
+ * @brief Compare the children of a mapping node to the current candidates and announce
+ *        the differences to attached views.
+ *
+ * Children that are still shown keep their rows as long as their order is preserved;
+ * the other children are removed and the missing candidates inserted, both in contiguous
+ * ranges of rows.
+ */
+void FilteredTaskItemModel::update_children(MappingNode* mapping_node) {
+    if (
+        !mapping_node->children_mapped
+        || (mapping_node != &this->mapping_root && this->tree_model->find_graph_node(mapping_node->uuid) == nullptr)
+    ) {
+        // The item has been destroyed, the node is removed together with its parent's outdated row.
+        return;
+    }
+
+    this->unregister_visitor(mapping_node);
+    mapping_node->visited_items.clear();
+    auto candidates = this->find_children(mapping_node, mapping_node->visited_items);
+    this->register_visitor(mapping_node);
+
+    QHash<TaskId, int> candidate_positions;
+    for (int position=0; position<static_cast<int>(candidates.size()); position++) {
+        candidate_positions.insert(candidates[position].uuid, position);
+    }
+    std::vector<bool> is_kept(mapping_node->children.size(), false);
+    int last_kept_position = -1;
+    for (std::size_t row=0; row<mapping_node->children.size(); row++) {
+        const auto position = candidate_positions.value(mapping_node->children[row]->uuid, -1);
+        if (position > last_kept_position) {
+            is_kept[row] = true;
+            last_kept_position = position;
+        }
+    }
+    this->remove_children(mapping_node, is_kept);
+
+    int row = 0;
+    std::vector<Candidate> new_candidates;
+    for (auto& candidate : candidates) {
+        if (row < static_cast<int>(mapping_node->children.size()) && mapping_node->children[row]->uuid == candidate.uuid) {
+            this->insert_children(mapping_node, row, new_candidates);
+            row += static_cast<int>(new_candidates.size());
+            new_candidates.clear();
+
+            auto* child = mapping_node->children[row++].get();
+            child->hidden_path = std::move(candidate.hidden_path);
+            if (child->top_level_uuid != candidate.top_level_uuid) {
+                child->top_level_uuid = candidate.top_level_uuid;
+                if (child->children_mapped) {
+                    this->outdated_nodes.insert(child);
+                }
+            }
+            continue;
+        }
+        new_candidates.push_back(std::move(candidate));
+    }
+    this->insert_children(mapping_node, row, new_candidates);
+}
+
+/**
+ * @brief Remove the children of a mapping node that are not kept, starting with the last
+ *        contiguous range so that the rows of the remaining ranges stay valid.
+ */
+void FilteredTaskItemModel::remove_children(MappingNode* mapping_node, const std::vector<bool>& is_kept) {
+    const auto parent_index = this->create_proxy_index(mapping_node);
+    auto& children = mapping_node->children;
+    for (int last_row=static_cast<int>(is_kept.size())-1; last_row>=0; last_row--) {
+        if (is_kept[last_row]) {
+            continue;
+        }
+        int first_row = last_row;
+        while (first_row > 0 && !is_kept[first_row - 1]) {
+            first_row--;
+        }
+
+        this->beginRemoveRows(parent_index, first_row, last_row);
+        for (int row=first_row; row<=last_row; row++) {
+            this->unregister_subtree(children[row].get());
+            mapping_node->children_by_uuid.remove(children[row]->uuid);
+        }
+        children.erase(children.begin() + first_row, children.begin() + last_row + 1);
+        FilteredTaskItemModel::update_rows(mapping_node, first_row);
+        this->endRemoveRows();
+        last_row = first_row;
+    }
+}
+
+/**
+ * @brief Insert consecutive children into a mapping node at the given row.
+ */
+void FilteredTaskItemModel::insert_children(
+    MappingNode* mapping_node,
+    int row,
+    const std::vector<Candidate>& candidates
+) {
+    if (candidates.empty()) {
+        return;
+    }
+
+    const auto count = static_cast<int>(candidates.size());
+    this->beginInsertRows(this->create_proxy_index(mapping_node), row, row + count - 1);
+    std::vector<std::unique_ptr<MappingNode>> children;
+    children.reserve(candidates.size());
+    for (const auto& candidate : candidates) {
+        children.push_back(std::make_unique<MappingNode>(
+            candidate.uuid,
+            candidate.top_level_uuid,
+            candidate.hidden_path,
+            mapping_node
+        ));
+        this->mapping_nodes.insert(candidate.uuid, children.back().get());
+        mapping_node->children_by_uuid.insert(candidate.uuid, children.back().get());
+    }
+    mapping_node->children.insert(
+        mapping_node->children.begin() + row,
+        std::make_move_iterator(children.begin()),
+        std::make_move_iterator(children.end())
+    );
+    FilteredTaskItemModel::update_rows(mapping_node, row);
+    this->endInsertRows();
+}
+
+QModelIndex FilteredTaskItemModel::mapFromSource(const QModelIndex &sourceIndex) const {
+    if (!sourceIndex.isValid() || this->tree_model == nullptr) {
         return {};
     }
-    return {};
+
+    // Follow the source path, skipping the items that are hidden between two rows:
+    const auto path = this->tree_model->get_path(sourceIndex);
+    auto* mapping_node = &this->mapping_root;
+    qsizetype first = 0;
+    while (first < path.size()) {
+        this->map_children(mapping_node);
+        MappingNode* child = nullptr;
+        qsizetype position = first;
+        for (; position < path.size(); position++) {
+            auto* candidate = mapping_node->children_by_uuid.value(path[position]);
+            if (candidate != nullptr && candidate->hidden_path == path.mid(first, position - first)) {
+                child = candidate;
+                break;
+            }
+        }
+        if (child == nullptr) {
+            return {};
+        }
+        mapping_node = child;
+        first = position + 1;
+    }
+    return this->create_proxy_index(mapping_node);
+}
+
+QModelIndex FilteredTaskItemModel::mapToSource(const QModelIndex &proxyIndex) const {
+    if (!proxyIndex.isValid() || this->tree_model == nullptr) {
+        return {};
+    }
+
+    std::vector<const MappingNode*> mapping_path;
+    for (const auto* mapping_node = this->get_mapping_node(proxyIndex); mapping_node != &this->mapping_root; mapping_node = mapping_node->parent) {
+        mapping_path.push_back(mapping_node);
+    }
+    QList<TaskId> path;
+    for (auto mapping_node = mapping_path.rbegin(); mapping_node != mapping_path.rend(); ++mapping_node) {
+        path.append((*mapping_node)->hidden_path);
+        path.append((*mapping_node)->uuid);
+    }
+    return this->tree_model->find_index(path);
 }
 
 
 QModelIndex FilteredTaskItemModel::index(int row, int column, const QModelIndex &parent) const {
-    if ((row < 0) || (column > 0) || (row >= this->rowCount(parent))) {
+    if ((row < 0) || (column != 0) || (row >= this->rowCount(parent))) {
         return {};
     }
 
-    const auto it_first_child = this->proxy_children.constFind(parent);
-    return *std::next(it_first_child, this->rowCount(parent) - row - 1);
+    const auto* parent_node = this->get_mapping_node(parent);
+    return this->createIndex(row, column, parent_node->children.at(row).get());
 }
 
 QModelIndex FilteredTaskItemModel::parent(const QModelIndex &child_index) const {
-    return this->find_proxy_parent(this->mapToSource(child_index));
+    if (!child_index.isValid()) {
+        return {};
+    }
+    return this->create_proxy_index(this->get_mapping_node(child_index)->parent);
 }
 
 int FilteredTaskItemModel::columnCount(const QModelIndex & /* parent */) const {
@@ -283,40 +946,120 @@ int FilteredTaskItemModel::columnCount(const QModelIndex & /* parent */) const {
 }
 
 int FilteredTaskItemModel::rowCount(const QModelIndex &parent) const {
-    return static_cast<int>(this->proxy_children.count(parent));
+    auto* mapping_node = this->get_mapping_node(parent);
+    this->map_children(mapping_node);
+    return static_cast<int>(mapping_node->children.size());
 }
 
 bool FilteredTaskItemModel::hasChildren(const QModelIndex &parent) const {
-    return this->proxy_children.contains(parent);
+    return this->rowCount(parent) > 0;
 }
 
 QVariant FilteredTaskItemModel::data(const QModelIndex &index, int role) const {
-    if (index.isValid()) {
-        return static_cast<TreeNode *>(index.internalPointer())->get_data(role);
+    if (index.isValid() && this->tree_model != nullptr) {
+        return this->tree_model->data(this->get_mapping_node(index)->uuid, role);
     }
     return {};
 }
 
-void FilteredTaskItemModel::source_data_changed(
-    const QModelIndex &topLeft,
-    const QModelIndex &bottomRight,
-    const QList<int> &roles
-) {
-    auto proxy_top_left = this->mapFromSource(topLeft);
-    auto proxy_bottom_right = this->mapFromSource(bottomRight);
-    if (proxy_top_left.isValid() && proxy_bottom_right.isValid()) {
-        emit this->dataChanged(proxy_top_left, proxy_bottom_right, roles);
-    } else {
-        auto first_index = this->index(0, 0);
-        auto last_index = QModelIndex();
-        while (this->hasChildren(last_index)) {
-            last_index = this->index(this->rowCount(last_index) - 1, 0, last_index);
+/**
+ * @brief The default flags; unlike QAbstractProxyModel, this does not map to the source.
+ */
+Qt::ItemFlags FilteredTaskItemModel::flags(const QModelIndex& index) const {
+    return QAbstractItemModel::flags(index); // NOLINT(bugprone-parent-virtual-call)
+}
+
+/**
+ * @brief Announce a data change for every row that shows the task.
+ */
+void FilteredTaskItemModel::forward_data_changed(const TaskId& task, const QList<int>& roles) {
+    for (const auto* mapping_node : this->mapping_nodes.values(task)) {
+        const auto proxy_index = this->create_proxy_index(mapping_node);
+        emit this->dataChanged(proxy_index, proxy_index, roles);
+    }
+}
+
+void FilteredTaskItemModel::source_item_created(const TaskId& task) {
+    // The item is announced with its first relation; only the stores changed so far:
+    this->update_search_candidate(task);
+    this->update_status_mask(task);
+    this->selected_tag_bitset_outdated = true;
+}
+
+void FilteredTaskItemModel::source_items_destroyed(const QList<TaskId>& tasks) {
+    for (const auto& task : tasks) {
+        this->update_search_candidate(task);
+        this->remove_match(task);
+    }
+    // The rows of the items are removed when the relations to them are announced.
+}
+
+void FilteredTaskItemModel::source_item_changed(const TaskId& task, const QList<int>& roles) {
+    const bool filter_changed = !this->filter_roles.has_value() || depends_on_roles(roles, *this->filter_roles);
+    const bool search_changed = depends_on_roles(roles, search_roles);
+    const bool tags_changed = depends_on_roles(roles, tag_roles);
+    if (filter_changed) {
+        this->update_status_mask(task);
+    }
+    if (search_changed) {
+        this->update_search_candidate(task);
+    }
+    this->selected_tag_bitset_outdated |= tags_changed;
+
+    // The stored tags of matching tasks are kept up to date even if they are not shown:
+    if (filter_changed || (search_changed && !this->filter_words.isEmpty()) || tags_changed) {
+        const auto* graph_node = this->tree_model->find_graph_node(task);
+        if (filter_changed && graph_node != nullptr && this->is_top_level_task(*graph_node)) {
+            this->update_matches_of_subtree(task);
+            this->mark_top_level_task_outdated(task);
+        } else {
+            this->update_match(task);
         }
-        emit this->dataChanged(first_index, last_index);
+        this->mark_visitors_outdated(task);
+        this->update_outdated_nodes();
+        this->emit_remaining_tags_if_changed();
     }
+    this->forward_data_changed(task, roles);
+}
+
+/**
+ * @brief Update the rows after a relation was added; an invalid parent stands for the root.
+ *
+ * The child and its descendants may have got new top level tasks, and the filter function
+ * may depend on the children of the parent.
+ */
+void FilteredTaskItemModel::source_relation_added(const TaskId& parent, const TaskId& child) {
+    this->update_matches_of_subtree(child);
+    if (parent.is_valid()) {
+        this->update_match(parent);
+    }
+    this->mark_visitors_outdated(parent);
+    this->update_outdated_nodes();
+    this->emit_remaining_tags_if_changed();
+}
+
+/**
+ * @brief Update the rows after relations were removed; an invalid parent stands for the root.
+ *
+ * The parent and the children may have been destroyed already, see TreeItemModel.
+ */
+void FilteredTaskItemModel::source_relations_removed(const TaskId& parent, const QList<TaskId>& children) {
+    for (const auto& child : children) {
+        this->update_matches_of_subtree(child);
+    }
+    if (parent.is_valid()) {
+        this->update_match(parent);
+    }
+    this->mark_visitors_outdated(parent);
+    this->update_outdated_nodes();
+    this->emit_remaining_tags_if_changed();
 }
 
 void FilteredTaskItemModel::source_model_changed() {
-    this->rebuild_index_mapping();
+    this->search_candidates_outdated = true;
+    this->status_mask_outdated = true;
+    this->selected_tag_bitset_outdated = true;
+    this->reset_mapping();
+    this->rebuild_matches();
     this->endResetModel();
 }
@@ -19,51 +19,195 @@
 #pragma once
 
 #include <functional>
+#include <memory>
+#include <optional>
 #include <utility>
+#include <vector>
 
 #include <QAbstractProxyModel>
+#include <QHash>
+#include <QList>
 #include <QModelIndex>
 #include <QMultiHash>
 #include <QObject>
+#include <QPointer>
 #include <QRegularExpression>
+#include <QSet>
 #include <QStringList>
 
+#include "dataitems/graphnode.h"
 #include "dataitems/qtdid.h"
+#include "tagnumbering.h"
+#include "taskcolumnstore.h"
+#include "tasksearchindex.h"
+#include "treeitemmodel.h"
+#include "utils/densebitset.h"
 
 class FilteredTaskItemModel : public QAbstractProxyModel
 {
     Q_OBJECT
 
 public:
-    using TaskFilterFunction = std::function<bool(const QModelIndex&)>;
+    /**
+     * @brief Decides whether a task is shown below a top level task it descends from.
+     *
+     * The function may depend on the data of both tasks and on the children of the task.
+     */
+    using TaskFilterFunction = std::function<bool(const GraphNode& task, const GraphNode& top_level_task)>;
 
 private:
+    /**
+     * @brief A node of the filtered tree; it represents one path through the source graph.
+     */
+    struct MappingNode {
+        TaskId uuid;
+        TaskId top_level_uuid;
+
+        /**
+         * @brief The source items between the parent and this node, which are not shown
+         */
+        QList<TaskId> hidden_path;
+
+        MappingNode* parent;
+        int row = 0;
+        std::vector<std::unique_ptr<MappingNode>> children;
+        QHash<TaskId, MappingNode*> children_by_uuid;
+
+        /**
+         * @brief The source items whose data or children determined the children
+         */
+        QSet<TaskId> visited_items;
+        bool children_mapped = false;
+
+        MappingNode(TaskId uuid, TaskId top_level_uuid, QList<TaskId> hidden_path, MappingNode* parent)
+            : uuid(std::move(uuid)),
+              top_level_uuid(std::move(top_level_uuid)),
+              hidden_path(std::move(hidden_path)),
+              parent(parent) {}
+    };
+
+    /**
+     * @brief A source item that is shown as a child of a mapping node
+     */
+    struct Candidate {
+        TaskId uuid;
+        TaskId top_level_uuid;
+        QList<TaskId> hidden_path;
+    };
+
     const static char* split_pattern;
 
     const TaskFilterFunction is_task_accepted;
+    QPointer<const TreeItemModel> tree_model;
+
+    /**
+     * @brief Roles the filter function depends on; std::nullopt if unknown, i.e. all roles
+     */
+    std::optional<QList<int>> filter_roles;
+
     QStringList filter_words;
-    QMultiHash<TaskId, std::pair<QModelIndex, QModelIndex>> index_mapping;
-    QMultiHash<QModelIndex, QModelIndex> proxy_children;
     QRegularExpression split_regex;
-    QSet<TagId> remaining_tags;
     QSet<TagId> selected_tags;
+    mutable DenseBitset selected_tag_bitset;
+    mutable bool selected_tag_bitset_outdated = true;
+
+    /**
+     * @brief Numbers the tags if no column store is set; otherwise, the numbering of the store is used
+     */
+    mutable TagNumbering own_tag_numbering;
+
+    /**
+     * @brief Optional full-text index of the source model used to narrow down search results
+     */
+    QPointer<const TaskSearchIndex> search_index;
+    mutable std::optional<QSet<TaskId>> search_candidates;
+    mutable bool search_candidates_outdated = true;
+
+    /**
+     * @brief Optional column store of the source model used instead of the filter function
+     */
+    QPointer<const TaskColumnStore> column_store;
+    std::optional<TaskColumnStore::Filter> column_filter;
+    mutable std::vector<quint8> status_mask;
+    mutable bool status_mask_outdated = true;
+
+    /**
+     * @brief The children of a mapping node are only mapped once they are requested
+     */
+    mutable MappingNode mapping_root{TaskId(), TaskId(), {}, nullptr};
+    mutable QMultiHash<TaskId, MappingNode*> mapping_nodes;
+    mutable QMultiHash<TaskId, MappingNode*> visitors;
+    QSet<MappingNode*> outdated_nodes;
+
+    /**
+     * @brief Tasks accepted below one of their top level tasks and matching the search string, with their tags
+     */
+    QHash<TaskId, DenseBitset> matching_tasks;
+
+    /**
+     * @brief Number of matching tasks per tag number
+     */
+    std::vector<qsizetype> remaining_tag_count;
+    bool remaining_tags_changed = false;
 
     void reset_mapping();
-    void map_index(const QModelIndex& source_index);
-    void rebuild_index_mapping();
-    [[nodiscard]] bool index_matches_search_string(const QModelIndex& index) const;
-    [[nodiscard]] bool index_matches_tag_selection(const QModelIndex& index) const;
-    [[nodiscard]] QModelIndex find_proxy_parent(const QModelIndex& source_index) const;
-    [[nodiscard]] bool is_child(const TaskId& child, const QModelIndex& parent) const;
+    void rebuild_matches();
+    void map_children(MappingNode* mapping_node) const;
+    [[nodiscard]] std::vector<Candidate> find_children(const MappingNode* mapping_node, QSet<TaskId>& visited_items) const;
+    void register_visitor(MappingNode* mapping_node) const;
+    void unregister_visitor(MappingNode* mapping_node) const;
+    void unregister_subtree(MappingNode* mapping_node);
+    void mark_visitors_outdated(const TaskId& task);
+    void mark_top_level_task_outdated(const TaskId& top_level_task);
+    void update_outdated_nodes();
+    void update_children(MappingNode* mapping_node);
+    void remove_children(MappingNode* mapping_node, const std::vector<bool>& is_kept);
+    void insert_children(MappingNode* mapping_node, int row, const std::vector<Candidate>& candidates);
+    void forward_data_changed(const TaskId& task, const QList<int>& roles);
+
+    void add_match(const TaskId& task, const DenseBitset& tags);
+    void remove_match(const TaskId& task);
+    void update_match(const TaskId& task);
+    void update_matches_of_subtree(const TaskId& task);
+    [[nodiscard]] bool is_match(const GraphNode& task) const;
+    [[nodiscard]] QSet<TagId> get_remaining_tags() const;
+    void emit_remaining_tags_if_changed();
+
+    [[nodiscard]] const std::optional<QSet<TaskId>>& get_search_candidates() const;
+    [[nodiscard]] const std::vector<quint8>& get_status_mask() const;
+    void update_search_candidate(const TaskId& task);
+    void update_status_mask(const TaskId& task);
+    [[nodiscard]] const TagNumbering& get_tag_numbering() const;
+    [[nodiscard]] DenseBitset get_tag_bitset(const GraphNode& task) const;
+    [[nodiscard]] const DenseBitset& get_selected_tag_bitset() const;
+    [[nodiscard]] bool is_accepted(const GraphNode& task, const GraphNode& top_level_task) const;
+    [[nodiscard]] bool task_matches_search_string(const GraphNode& task) const;
+    [[nodiscard]] bool matches_filter_words(const GraphNode& task) const;
+    [[nodiscard]] bool tags_match_tag_selection(const DenseBitset& tags) const;
+    [[nodiscard]] bool is_shown(const GraphNode& task, const GraphNode& top_level_task) const;
+    [[nodiscard]] bool is_top_level_task(const GraphNode& task) const;
+
+    [[nodiscard]] MappingNode* get_mapping_node(const QModelIndex& proxy_index) const;
+    [[nodiscard]] QModelIndex create_proxy_index(const MappingNode* mapping_node) const;
+    static void update_rows(MappingNode* parent, int first_row);
+
     void setup_signal_slot_connections();
+    void source_item_created(const TaskId& task);
+    void source_items_destroyed(const QList<TaskId>& tasks);
+    void source_item_changed(const TaskId& task, const QList<int>& roles);
+    void source_relation_added(const TaskId& parent, const TaskId& child);
+    void source_relations_removed(const TaskId& parent, const QList<TaskId>& children);
 
 public:
     explicit FilteredTaskItemModel(
-        TaskFilterFunction is_task_accepted = [](const QModelIndex&) { return true; },
+        TaskFilterFunction is_task_accepted = [](const GraphNode&, const GraphNode&) { return true; },
         QObject* parent = nullptr
     );
 
     void setSourceModel(QAbstractItemModel* sourceModel) override;
+    void set_search_index(const TaskSearchIndex* search_index);
+    void set_column_filter(const TaskColumnStore* column_store, TaskColumnStore::Filter filter);
+    void set_filter_roles(const QList<int>& roles);
     void set_search_string(const QString& search_string);
     void clear_search_string();
 
@@ -79,16 +223,12 @@ public:
     [[nodiscard]] QModelIndex parent(const QModelIndex& child_index) const override;
 
     [[nodiscard]] int columnCount(const QModelIndex &parent = QModelIndex()) const override;
-    [[nodiscard]] int rowCount(const QModelIndex& /* parent */ = QModelIndex()) const override;
+    [[nodiscard]] int rowCount(const QModelIndex& parent = QModelIndex()) const override;
     [[nodiscard]] bool hasChildren(const QModelIndex& parent) const override;
     [[nodiscard]] QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+    [[nodiscard]] Qt::ItemFlags flags(const QModelIndex& index) const override;
 
 public slots:
-    void source_data_changed(
-        const QModelIndex& topLeft,
-        const QModelIndex& bottomRight,
-        const QList<int>& roles = QList<int>()
-    );
     void source_model_changed();
     void set_selected_tags(const QSet<TagId>& tags);
 
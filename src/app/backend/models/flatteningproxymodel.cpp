@@ -18,28 +18,49 @@
 
 #include "flatteningproxymodel.h"
 
+#include <algorithm>
 #include <functional>
+#include <vector>
 
 #include <QAbstractProxyModel>
 #include <QList>
 #include <QObject>
+#include <QPersistentModelIndex>
 
 #include "dataitems/qtditemdatarole.h"
 #include "utils/modeliteration.h"
 
-QModelIndex FlatteningProxyModel::find_source_model_index(int proxy_row) const {
-    QModelIndex current_index = sourceModel()->index(0, 0);
-    while (proxy_row > 0) {
-        current_index = ModelIteration::next_row_index_depth_first(sourceModel(), current_index);
-        proxy_row--;
+/**
+ * @class FlatteningProxyModel
+ * @brief A proxy model that presents all rows of a tree model as a flat list in depth first order.
+ *
+ * The source indices are cached in depth first order and the cache is updated incrementally
+ * when rows are inserted, removed or moved in the source model. Therefore, index(), mapToSource()
+ * and rowCount() run in constant time, mapFromSource() uses a binary search.
+ */
+
+namespace {
+
+QList<int> get_row_path(QModelIndex index) {
+    QList<int> path;
+    while (index.isValid()) {
+        path.prepend(index.row());
+        index = index.parent();
     }
-    return current_index;
+    return path;
 }
 
+} // anonymous namespace
+
 FlatteningProxyModel::FlatteningProxyModel(QObject *parent)
     : QAbstractProxyModel(parent) {}
 
 void FlatteningProxyModel::setSourceModel(QAbstractItemModel* model) {
+    this->beginResetModel();
+    if (this->sourceModel() != nullptr) {
+        this->sourceModel()->disconnect(this);
+    }
+
     QObject::connect(
         model, &QAbstractItemModel::rowsAboutToBeRemoved,
         this, &FlatteningProxyModel::on_rows_about_to_be_removed
@@ -52,15 +73,94 @@ void FlatteningProxyModel::setSourceModel(QAbstractItemModel* model) {
         model, &QAbstractItemModel::dataChanged,
         this, &FlatteningProxyModel::on_data_changed
     );
-    QObject::connect(
-        model, &QAbstractItemModel::rowsAboutToBeInserted,
-        this, &FlatteningProxyModel::on_rows_about_to_be_inserted
-    );
     QObject::connect(
         model, &QAbstractItemModel::rowsInserted,
         this, &FlatteningProxyModel::on_rows_inserted
     );
+    QObject::connect(
+        model, &QAbstractItemModel::rowsAboutToBeMoved,
+        this, &FlatteningProxyModel::on_rows_about_to_be_moved
+    );
+    QObject::connect(
+        model, &QAbstractItemModel::rowsMoved,
+        this, &FlatteningProxyModel::on_rows_moved
+    );
+    QObject::connect(
+        model, &QAbstractItemModel::layoutAboutToBeChanged,
+        this, &FlatteningProxyModel::beginResetModel
+    );
+    QObject::connect(
+        model, &QAbstractItemModel::layoutChanged,
+        this, &FlatteningProxyModel::on_model_reset
+    );
+    QObject::connect(
+        model, &QAbstractItemModel::modelAboutToBeReset,
+        this, &FlatteningProxyModel::beginResetModel
+    );
+    QObject::connect(
+        model, &QAbstractItemModel::modelReset,
+        this, &FlatteningProxyModel::on_model_reset
+    );
     QAbstractProxyModel::setSourceModel(model);
+
+    this->rebuild_flattened_source_indices();
+    this->endResetModel();
+}
+
+void FlatteningProxyModel::rebuild_flattened_source_indices() {
+    this->flattened_source_indices.clear();
+    if (this->sourceModel() == nullptr) {
+        return;
+    }
+    this->flattened_source_indices = this->flatten_source_rows(
+        QModelIndex(), 0, this->sourceModel()->rowCount() - 1
+    );
+}
+
+/**
+ * @brief Collect the given source rows and all their (recursive) children in depth first order.
+ */
+std::vector<QPersistentModelIndex> FlatteningProxyModel::flatten_source_rows(
+    const QModelIndex& parent,
+    int first,
+    int last
+) const {
+    std::vector<QPersistentModelIndex> result;
+    for (int row=first; row<=last; row++) {
+        ModelIteration::model_foreach(
+            *this->sourceModel(),
+            [&result](const QModelIndex& index) { result.emplace_back(index); },
+            this->sourceModel()->index(row, 0, parent)
+        );
+    }
+    return result;
+}
+
+/**
+ * @brief Find the proxy row of a source index by a binary search in the given range.
+ *
+ * If the source index is not part of the cache, the row at which it would have
+ * to be inserted is returned.
+ */
+int FlatteningProxyModel::find_proxy_row(
+    const QModelIndex& source_index,
+    int begin_row,
+    int end_row
+) const {
+    if (end_row < 0) {
+        end_row = static_cast<int>(this->flattened_source_indices.size());
+    }
+
+    const auto row_path = get_row_path(source_index);
+    const auto begin = this->flattened_source_indices.cbegin();
+    const auto position = std::partition_point(
+        begin + begin_row,
+        begin + end_row,
+        [&row_path](const QPersistentModelIndex& index) {
+            return get_row_path(index) < row_path;
+        }
+    );
+    return static_cast<int>(position - begin);
 }
 
 void FlatteningProxyModel::on_rows_about_to_be_removed(
@@ -68,14 +168,17 @@ void FlatteningProxyModel::on_rows_about_to_be_removed(
     int first,
     int last
 ) {
-    const auto proxy_parent = this->mapFromSource(parent);
-    const int first_proxy_row = proxy_parent.row() + 1 + first;
+    const int first_proxy_row = this->mapFromSource(this->sourceModel()->index(first, 0, parent)).row();
 
     const auto last_src_index = this->sourceModel()->index(last, 0, parent);
     const int last_src_index_child_count = ModelIteration::count_model_rows(this->sourceModel(), last_src_index) - 1;
     const int last_proxy_row = this->mapFromSource(last_src_index).row() + last_src_index_child_count;
 
     this->beginRemoveRows(QModelIndex(), first_proxy_row, last_proxy_row);
+    this->flattened_source_indices.erase(
+        this->flattened_source_indices.begin() + first_proxy_row,
+        this->flattened_source_indices.begin() + last_proxy_row + 1
+    );
 }
 
 void FlatteningProxyModel::on_rows_removed(
@@ -99,33 +202,88 @@ void FlatteningProxyModel::on_data_changed(
 }
 
 /**
- * @brief Emits a signal for rows about to be inserted.
+ * @brief Insert the new source rows and all their children into the cache.
  *
  * Since the signature of QAbstractItemModel::rowsAboutToBeInserted does not
  * allow reacting to nested inserts (i.e. inserting rows that already have
- * children themselves), the current implementation resets the entire model.
- *
- * For a more sophisticated solution it would be required to know the number
- * of nested children of the about to be inserted rows.
+ * children themselves), the insertion is announced once the source model
+ * has finished inserting.
  */
-void FlatteningProxyModel::on_rows_about_to_be_inserted(
-    const QModelIndex& /*parent*/,
-    int /*first*/,
-    int /*last*/
+void FlatteningProxyModel::on_rows_inserted(
+    const QModelIndex& parent,
+    int first,
+    int last
 ) {
-    this->beginResetModel();
+    const auto new_indices = this->flatten_source_rows(parent, first, last);
+    const int first_proxy_row = this->find_proxy_row(this->sourceModel()->index(first, 0, parent));
+
+    this->beginInsertRows(
+        QModelIndex(),
+        first_proxy_row,
+        first_proxy_row + static_cast<int>(new_indices.size()) - 1
+    );
+    this->flattened_source_indices.insert(
+        this->flattened_source_indices.begin() + first_proxy_row,
+        new_indices.begin(),
+        new_indices.end()
+    );
+    this->endInsertRows();
+}
+
+void FlatteningProxyModel::on_rows_about_to_be_moved(
+    const QModelIndex& source_parent,
+    int source_start,
+    int source_end,
+    const QModelIndex& /* destination_parent */,
+    int /* destination_row */
+) {
+    const auto first_src_index = this->sourceModel()->index(source_start, 0, source_parent);
+    const auto last_src_index = this->sourceModel()->index(source_end, 0, source_parent);
+    const int last_src_index_child_count = ModelIteration::count_model_rows(this->sourceModel(), last_src_index) - 1;
+
+    this->moved_proxy_rows = {
+        this->mapFromSource(first_src_index).row(),
+        this->mapFromSource(last_src_index).row() + last_src_index_child_count
+    };
 }
 
 /**
- * @brief Emits a signal after row insertion was completed
+ * @brief Move the cached rows to their new position once the source model has finished moving.
  *
- * \sa FlatteningProxyModel::on_rows_about_to_be_inserted
+ * The cached persistent indices already point to the new source positions. Apart from the
+ * moved rows, the cache is still in depth first order, so the destination can be found by
+ * a binary search that skips the moved rows.
  */
-void FlatteningProxyModel::on_rows_inserted(
-    const QModelIndex& /* parent */,
-    int /* first */,
-    int /* last */
+void FlatteningProxyModel::on_rows_moved(
+    const QModelIndex& /* source_parent */,
+    int /* source_start */,
+    int /* source_end */,
+    const QModelIndex& /* destination_parent */,
+    int /* destination_row */
 ) {
+    const auto [first_row, last_row] = this->moved_proxy_rows;
+    const auto first_moved_index = QModelIndex(this->flattened_source_indices.at(first_row));
+
+    int destination = this->find_proxy_row(first_moved_index, 0, first_row);
+    if (destination == first_row) {
+        destination = this->find_proxy_row(first_moved_index, last_row + 1);
+    }
+    if (destination == last_row + 1) {
+        return;
+    }
+
+    this->beginMoveRows(QModelIndex(), first_row, last_row, QModelIndex(), destination);
+    auto begin = this->flattened_source_indices.begin();
+    if (destination < first_row) {
+        std::rotate(begin + destination, begin + first_row, begin + last_row + 1);
+    } else {
+        std::rotate(begin + first_row, begin + last_row + 1, begin + destination);
+    }
+    this->endMoveRows();
+}
+
+void FlatteningProxyModel::on_model_reset() {
+    this->rebuild_flattened_source_indices();
     this->endResetModel();
 }
 
@@ -134,32 +292,36 @@ QModelIndex FlatteningProxyModel::mapFromSource(const QModelIndex& sourceIndex)
         return {};
     }
 
-    int proxy_row = -1;
-    const std::function<bool(const QModelIndex&)> find_source_index_operation
-        = [&proxy_row, &sourceIndex](const QModelIndex& index) -> bool
-    {
-        proxy_row++;
-        return index == sourceIndex;
-    };
-
-    ModelIteration::model_foreach(*this->sourceModel(), find_source_index_operation);
+    const auto first_column_index = sourceIndex.siblingAtColumn(0);
+    const int proxy_row = this->find_proxy_row(first_column_index);
+    if (
+        proxy_row >= this->rowCount()
+        || this->flattened_source_indices.at(proxy_row) != first_column_index
+    ) {
+        return {};
+    }
     return createIndex(proxy_row, sourceIndex.column(), sourceIndex.internalPointer());
 }
 
 QModelIndex FlatteningProxyModel::mapToSource(const QModelIndex& proxyIndex) const {
-    if (!proxyIndex.isValid()) {
+    if (!proxyIndex.isValid() || proxyIndex.row() >= this->rowCount()) {
         return {};
     }
-    return find_source_model_index(proxyIndex.row());
+    return this->flattened_source_indices.at(proxyIndex.row());
 }
 
 QModelIndex FlatteningProxyModel::index(int row, int column, const QModelIndex& parent) const {
-    if (parent.isValid() || (row < 0) || (column > 0)) {
+    if (
+        parent.isValid() || (row < 0) || (column > 0)
+        || (row >= this->rowCount())
+    ) {
         return {};
     }
-    auto source_model_index = this->find_source_model_index(row);
-    auto result = this->createIndex(row, column, source_model_index.internalPointer());
-    return result;
+    return this->createIndex(
+        row,
+        column,
+        this->flattened_source_indices.at(row).internalPointer()
+    );
 }
 
 QModelIndex FlatteningProxyModel::parent(const QModelIndex& /* child */) const {
@@ -174,7 +336,7 @@ QModelIndex FlatteningProxyModel::sibling(int row, int column, const QModelIndex
 }
 
 int FlatteningProxyModel::rowCount(const QModelIndex& parent) const {
-    return parent.isValid() ? 0 : ModelIteration::count_model_rows(this->sourceModel());
+    return parent.isValid() ? 0 : static_cast<int>(this->flattened_source_indices.size());
 }
 
 int FlatteningProxyModel::columnCount(const QModelIndex& parent) const {
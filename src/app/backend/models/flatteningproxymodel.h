@@ -18,18 +18,38 @@
 
 #pragma once
 
+#include <utility>
+#include <vector>
+
 #include <QAbstractProxyModel>
 #include <QByteArray>
 #include <QHash>
+#include <QList>
 #include <QObject>
+#include <QPersistentModelIndex>
 
 class FlatteningProxyModel : public QAbstractProxyModel
 {
     Q_OBJECT
 
 private:
-    [[nodiscard]] int count_source_model_rows(const QModelIndex& index = QModelIndex()) const;
-    [[nodiscard]] QModelIndex find_source_model_index(int proxy_row) const;
+    /**
+     * @brief The source model indices in depth first (pre-)order; the position equals the proxy row.
+     */
+    std::vector<QPersistentModelIndex> flattened_source_indices;
+    std::pair<int, int> moved_proxy_rows{-1, -1};
+
+    void rebuild_flattened_source_indices();
+    [[nodiscard]] std::vector<QPersistentModelIndex> flatten_source_rows(
+        const QModelIndex& parent,
+        int first,
+        int last
+    ) const;
+    [[nodiscard]] int find_proxy_row(
+        const QModelIndex& source_index,
+        int begin_row = 0,
+        int end_row = -1
+    ) const;
 
     void on_rows_about_to_be_removed(const QModelIndex& parent, int first, int last);
     void on_rows_removed(const QModelIndex& /* parent */, int /* first */, int /* last */);
@@ -38,8 +58,22 @@ private:
         const QModelIndex& bottomRight,
         const QList<int>& roles = QList<int>()
     );
-    void on_rows_about_to_be_inserted(const QModelIndex& parent, int first, int last);
-    void on_rows_inserted(const QModelIndex& /* parent */, int /* first */, int /* last */);
+    void on_rows_inserted(const QModelIndex& parent, int first, int last);
+    void on_rows_about_to_be_moved(
+        const QModelIndex& source_parent,
+        int source_start,
+        int source_end,
+        const QModelIndex& /* destination_parent */,
+        int /* destination_row */
+    );
+    void on_rows_moved(
+        const QModelIndex& /* source_parent */,
+        int /* source_start */,
+        int /* source_end */,
+        const QModelIndex& /* destination_parent */,
+        int /* destination_row */
+    );
+    void on_model_reset();
 
 public:
     explicit FlatteningProxyModel(QObject* parent = nullptr);
@@ -18,33 +18,28 @@
 
 #include "mainpagemodelfilter.h"
 
-#include <QModelIndex>
-
+#include "dataitems/graphnode.h"
 #include "dataitems/qtditemdatarole.h"
 #include "dataitems/task.h"
 
-bool is_task_open(const QModelIndex& index) {
-    auto status = index.data(QtdItemDataRole::ActiveRole).value<Task::Status>();
-    auto title = index.data().toString();
-    return status == Task::Status::open;
-}
+namespace {
+    Task::Status get_status(const GraphNode& task) {
+        return task.get_data(QtdItemDataRole::ActiveRole).value<Task::Status>();
+    }
+} // anonymous namespace
 
-bool is_task_actionable(const QModelIndex& index) {
-    auto status = index.data(QtdItemDataRole::ActiveRole).value<Task::Status>();
-    return (status == Task::Status::open) && (index.model()->rowCount(index) == 0);
+bool is_task_open(const GraphNode& task, const GraphNode& /* top_level_task */) {
+    return get_status(task) == Task::Status::open;
 }
 
-bool is_task_in_open_project(const QModelIndex& index) {
-    auto top_ancestor = index;
-    while (top_ancestor.parent().isValid()) {
-        top_ancestor = top_ancestor.parent();
-    }
+bool is_task_actionable(const GraphNode& task, const GraphNode& /* top_level_task */) {
+    return (get_status(task) == Task::Status::open) && (task.get_child_count() == 0);
+}
 
-    auto status = top_ancestor.data(QtdItemDataRole::ActiveRole);
-    return status.value<Task::Status>() == Task::Status::open;
+bool is_task_in_open_project(const GraphNode& /* task */, const GraphNode& top_level_task) {
+    return get_status(top_level_task) == Task::Status::open;
 }
 
-bool is_task_closed(const QModelIndex& index) {
-    auto status = index.data(QtdItemDataRole::ActiveRole).value<Task::Status>();
-    return status == Task::Status::closed;
+bool is_task_closed(const GraphNode& task, const GraphNode& /* top_level_task */) {
+    return get_status(task) == Task::Status::closed;
 }
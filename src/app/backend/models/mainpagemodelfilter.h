@@ -18,9 +18,23 @@
 
 #pragma once
 
-#include <QModelIndex>
+#include <QList>
 
-bool is_task_open(const QModelIndex& index);
-bool is_task_actionable(const QModelIndex& index);
-bool is_task_in_open_project(const QModelIndex& index);
-bool is_task_closed(const QModelIndex& index);
+#include "dataitems/graphnode.h"
+#include "dataitems/qtditemdatarole.h"
+#include "dataitems/task.h"
+#include "taskcolumnstore.h"
+
+bool is_task_open(const GraphNode& task, const GraphNode& top_level_task);
+bool is_task_actionable(const GraphNode& task, const GraphNode& top_level_task);
+bool is_task_in_open_project(const GraphNode& task, const GraphNode& top_level_task);
+bool is_task_closed(const GraphNode& task, const GraphNode& top_level_task);
+
+// The roles the filter functions above depend on:
+inline const QList<int> task_filter_roles = {ActiveRole, StartRole, DueRole, ResolveRole};
+
+// Equivalent filters evaluated on the columns of a TaskColumnStore:
+constexpr TaskColumnStore::Filter open_task_filter{Task::Status::open};
+constexpr TaskColumnStore::Filter actionable_task_filter{Task::Status::open, TaskColumnStore::Filter::Scope::leaf_task};
+constexpr TaskColumnStore::Filter open_project_filter{Task::Status::open, TaskColumnStore::Filter::Scope::top_level_ancestor};
+constexpr TaskColumnStore::Filter closed_task_filter{Task::Status::closed};
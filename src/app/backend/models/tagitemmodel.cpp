@@ -18,72 +18,124 @@
 
 #include "tagitemmodel.h"
 
+#include <functional>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <QAbstractItemModel>
 #include <QColor>
 #include <QFile>
 #include <QHash>
+#include <QList>
+#include <QModelIndexList>
 #include <QObject>
+#include <QPair>
+#include <QString>
 #include <QTextStream>
 #include <QVariantList>
 
 #include "dataitems/qtdid.h"
 #include "dataitems/qtditemdatarole.h"
 #include "dataitems/tag.h"
+#include "dataitems/uniquedataitem.h"
+#include "repositories/persistencequeue.h"
+#include "repositories/startuploader.h"
 #include "repositories/tagrepository.h"
 #include "treeitemmodel.h"
 
 TagItemModel::TagItemModel(QString connection_name, QObject* parent)
     : TreeItemModel(parent), connection_name(std::move(connection_name))
 {
-    auto all_tags = TagRepository::create(this->connection_name).get_all_tags();
-    for (auto tag_iterator = all_tags.begin(); tag_iterator != all_tags.end(); ++tag_iterator) {
-        this->create_tree_node(
-            std::make_unique<Tag>(*tag_iterator),
-            tag_iterator.get_raw(TagRepository::columns::parent_uuid).value<TagId>()
-        );
+    this->build_tree(StartupLoader::load_tags(this->connection_name));
+}
+
+TagItemModel::TagItemModel(QString connection_name, std::vector<StartupLoader::LoadedTag> tags, QObject* parent)
+    : TreeItemModel(parent), connection_name(std::move(connection_name))
+{
+    this->build_tree(std::move(tags));
+}
+
+void TagItemModel::build_tree(std::vector<StartupLoader::LoadedTag> tags) {
+    std::vector<std::unique_ptr<UniqueDataItem>> data_items;
+    QList<QPair<TagId, TagId>> parents;
+    data_items.reserve(tags.size());
+    for (auto& [tag, parent_uuid] : tags) {
+        if (parent_uuid.is_valid()) {
+            parents.append({tag->get_uuid(), parent_uuid});
+        }
+        data_items.push_back(std::move(tag));
     }
+    this->load_tree(std::move(data_items), parents);
 }
 
 bool TagItemModel::setData(const QModelIndex& index, const QVariant& value, int role) {
     if (!index.isValid() || (role != Qt::DisplayRole && role != Qt::DecorationRole)) {
         return false;
     }
-    auto tag_repository = TagRepository::create(this->connection_name);
-    auto tag_uuid = index.data(UuidRole).value<TagId>();
-    const bool success = (role == Qt::DisplayRole)
-        ? tag_repository.update_name (value.toString(),      tag_uuid)
-        : tag_repository.update_color(value.value<QColor>(), tag_uuid);
-
-    return tag_repository.roll_back_on_failure(
-        success && TreeItemModel::setData(index, value, role)
+    const auto tag_uuid = index.data(UuidRole).value<TagId>();
+    return this->persist_change(
+        [tag_uuid, value, role](const TagRepository& tag_repository) {
+            return (role == Qt::DisplayRole)
+                ? tag_repository.update_name (value.toString(),      tag_uuid)
+                : tag_repository.update_color(value.value<QColor>(), tag_uuid);
+        },
+        [this, &index, &value, role]() { return TreeItemModel::setData(index, value, role); },
+        tag_uuid.toString() + '/' + QString::number(role)
     );
 }
 
 bool TagItemModel::create_tag(const QString& name, const QColor& color, const QModelIndex& parent) {
     auto new_tag = std::make_unique<Tag>(name, color);
+    const auto new_tag_uuid = new_tag->get_uuid();
     const TagId parent_uuid
         = parent.isValid() ? parent.data(UuidRole).value<TagId>() : TagId();
 
-    auto tag_repository = TagRepository::create(this->connection_name);
-    return tag_repository.roll_back_on_failure(
-        tag_repository.save(*new_tag, parent_uuid)
-        && this->create_tree_node(std::move(new_tag), parent_uuid)
+    return this->persist_change(
+        [name, color, new_tag_uuid, parent_uuid](const TagRepository& tag_repository) {
+            return tag_repository.save(Tag(name, color, new_tag_uuid.toString()), parent_uuid);
+        },
+        [this, &new_tag, &parent_uuid]() {
+            return this->create_tree_node(std::move(new_tag), parent_uuid);
+        }
     );
 }
 
 bool TagItemModel::removeRows(int row, int count, const QModelIndex &parent) {
-    QVariantList uuids_to_remove(count);
+    QVariantList uuids_to_remove;
+    uuids_to_remove.reserve(count);
     for (int i=row; i<row+count; i++) {
-        uuids_to_remove << this->index(i, 0, parent).data(UuidRole).toString();
+        uuids_to_remove << this->index(i, 0, parent).data(UuidRole);
+    }
+
+    return this->persist_change(
+        [uuids_to_remove](const TagRepository& tag_repository) {
+            return tag_repository.remove(uuids_to_remove);
+        },
+        [this, row, count, &parent]() { return TreeItemModel::removeRows(row, count, parent); }
+    );
+}
+
+/**
+ * @brief Remove several tags and their children, see TreeItemModel::remove_items.
+ *
+ * All tags are deleted from the database in one batch and transaction.
+ */
+bool TagItemModel::remove_items(const QModelIndexList& indexes) {
+    QVariantList uuids_to_remove;
+    uuids_to_remove.reserve(indexes.size());
+    for (const auto& index : indexes) {
+        if (!this->checkIndex(index, CheckIndexOption::IndexIsValid)) {
+            return false;
+        }
+        uuids_to_remove << index.data(UuidRole);
     }
 
-    auto tag_repository = TagRepository::create(this->connection_name);
-    return tag_repository.roll_back_on_failure(
-        tag_repository.remove(uuids_to_remove)
-        && TreeItemModel::removeRows(row, count, parent)
+    return this->persist_change(
+        [uuids_to_remove](const TagRepository& tag_repository) {
+            return tag_repository.remove(uuids_to_remove);
+        },
+        [this, &indexes]() { return TreeItemModel::remove_items(indexes); }
     );
 }
 
@@ -92,12 +144,57 @@ bool TagItemModel::change_parent(const QModelIndex& index, const TagId& new_pare
         return false;
     }
 
-    auto index_id = index.data(UuidRole).value<TagId>();
-    auto tag_repository = TagRepository::create(this->connection_name);
+    const auto index_id = index.data(UuidRole).value<TagId>();
+    return this->persist_change(
+        [new_parent, index_id](const TagRepository& tag_repository) {
+            return tag_repository.update_parent(new_parent, index_id);
+        },
+        [this, &index, &new_parent, &index_id]() {
+            return TreeItemModel::clone_tree_node(index_id, new_parent)
+                   && TreeItemModel::removeRows(index.row(), 1, index.parent());
+        }
+    );
+}
 
-    return tag_repository.roll_back_on_failure(
-        tag_repository.update_parent(new_parent, index_id)
-        && TreeItemModel::clone_tree_node(index_id, new_parent)
-        && TreeItemModel::removeRows(index.row(), 1, index.parent())
+/**
+ * @brief Switch to write-behind mode, see TaskItemModel::set_persistence_queue.
+ *
+ * Tags and tasks should share the queue, so that all changes are written in order.
+ */
+void TagItemModel::set_persistence_queue(PersistenceQueue* persistence_queue) {
+    if (this->persistence_queue != nullptr) {
+        this->persistence_queue->flush();
+        this->persistence_queue->disconnect(this);
+    }
+    this->persistence_queue = persistence_queue;
+    if (persistence_queue != nullptr) {
+        connect(
+            persistence_queue, &PersistenceQueue::flush_failed,
+            this, &TagItemModel::reload_from_db
+        );
+    }
+}
+
+/**
+ * @brief Replace the tags by the content of the database after a batch of changes failed.
+ */
+void TagItemModel::reload_from_db() {
+    this->build_tree(StartupLoader::load_tags(this->connection_name));
+}
+
+/**
+ * @brief Apply a change to the tree and persist it, see PersistenceQueue::apply_and_persist.
+ */
+bool TagItemModel::persist_change(
+    const std::function<bool(const TagRepository&)>& operation,
+    const std::function<bool()>& change_tree,
+    const QString& coalescing_key
+) {
+    return PersistenceQueue::apply_and_persist<TagRepository>(
+        this->persistence_queue.data(),
+        this->connection_name,
+        operation,
+        change_tree,
+        coalescing_key
     );
 }
@@ -18,10 +18,19 @@
 
 #pragma once
 
+#include <functional>
+#include <vector>
+
 #include <QColor>
+#include <QModelIndexList>
 #include <QObject>
+#include <QPointer>
+#include <QString>
 
 #include "dataitems/qtdid.h"
+#include "repositories/persistencequeue.h"
+#include "repositories/startuploader.h"
+#include "repositories/tagrepository.h"
 #include "treeitemmodel.h"
 
 class TagItemModel : public TreeItemModel
@@ -30,9 +39,18 @@ class TagItemModel : public TreeItemModel
 
 private:
     QString connection_name;
+    QPointer<PersistenceQueue> persistence_queue;
+
+    void build_tree(std::vector<StartupLoader::LoadedTag> tags);
+    bool persist_change(
+        const std::function<bool(const TagRepository&)>& operation,
+        const std::function<bool()>& change_tree,
+        const QString& coalescing_key = ""
+    );
 
 public:
     explicit TagItemModel(QString connection_name, QObject* parent = nullptr);
+    TagItemModel(QString connection_name, std::vector<StartupLoader::LoadedTag> tags, QObject* parent = nullptr);
 
     bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
     bool create_tag(
@@ -41,5 +59,8 @@ public:
         const QModelIndex& parent = QModelIndex()
     );
     bool removeRows(int row, int count, const QModelIndex& parent) override;
+    Q_INVOKABLE bool remove_items(const QModelIndexList& indexes) override;
     Q_INVOKABLE bool change_parent(const QModelIndex& index, const TagId& new_parent);
+    void set_persistence_queue(PersistenceQueue* persistence_queue);
+    void reload_from_db();
 };
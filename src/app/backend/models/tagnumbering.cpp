@@ -0,0 +1,75 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "tagnumbering.h"
+
+#include <QSet>
+
+#include "dataitems/qtdid.h"
+#include "utils/densebitset.h"
+
+qsizetype TagNumbering::assign_number(const TagId& tag) {
+    const auto number = this->numbers.constFind(tag);
+    if (number != this->numbers.cend()) {
+        return *number;
+    }
+    this->tags.push_back(tag);
+    return *this->numbers.insert(tag, this->tags.size() - 1);
+}
+
+/**
+ * @brief Returns the number of a tag or unknown_number if none was assigned yet.
+ */
+qsizetype TagNumbering::get_number(const TagId& tag) const {
+    return this->numbers.value(tag, unknown_number);
+}
+
+qsizetype TagNumbering::get_size() const {
+    return this->tags.size();
+}
+
+/**
+ * @brief Convert a set of tags into a bitset, assigning numbers to unknown tags.
+ */
+DenseBitset TagNumbering::assign_bitset(const QSet<TagId>& tags) {
+    DenseBitset result;
+    for (const auto& tag : tags) {
+        result.set(this->assign_number(tag));
+    }
+    return result;
+}
+
+/**
+ * @brief Convert a set of tags into a bitset; tags without a number are left out.
+ */
+DenseBitset TagNumbering::to_bitset(const QSet<TagId>& tags) const {
+    DenseBitset result;
+    for (const auto& tag : tags) {
+        const auto number = this->get_number(tag);
+        if (number != unknown_number) {
+            result.set(number);
+        }
+    }
+    return result;
+}
+
+QSet<TagId> TagNumbering::to_set(const DenseBitset& bitset) const {
+    QSet<TagId> result;
+    bitset.for_each([this, &result](qsizetype number) { result.insert(this->tags.at(number)); });
+    return result;
+}
@@ -0,0 +1,51 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QHash>
+#include <QList>
+#include <QSet>
+#include <QtTypes>
+
+#include "dataitems/qtdid.h"
+#include "utils/densebitset.h"
+
+/**
+ * @brief Maps tags to dense numbers, so that sets of tags can be stored as bitsets.
+ *
+ * Numbers are assigned in the order in which the tags are seen and are never reused;
+ * the number of tags is small compared to the number of tasks.
+ */
+class TagNumbering
+{
+private:
+    QHash<TagId, qsizetype> numbers;
+    QList<TagId> tags;
+
+public:
+    static constexpr qsizetype unknown_number = -1;
+
+    qsizetype assign_number(const TagId& tag);
+    [[nodiscard]] qsizetype get_number(const TagId& tag) const;
+    [[nodiscard]] qsizetype get_size() const;
+
+    DenseBitset assign_bitset(const QSet<TagId>& tags);
+    [[nodiscard]] DenseBitset to_bitset(const QSet<TagId>& tags) const;
+    [[nodiscard]] QSet<TagId> to_set(const DenseBitset& bitset) const;
+};
@@ -0,0 +1,174 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "taskcolumnstore.h"
+
+#include <algorithm>
+#include <span>
+#include <vector>
+
+#include <QDateTime>
+#include <QList>
+#include <QObject>
+#include <QSet>
+
+#include "dataitems/qtdid.h"
+#include "dataitems/qtditemdatarole.h"
+#include "dataitems/task.h"
+#include "tagnumbering.h"
+#include "treeitemmodel.h"
+#include "utils/densebitset.h"
+
+namespace {
+    qint64 to_column_value(const QDateTime& datetime) {
+        return datetime.isValid() ? datetime.toMSecsSinceEpoch() : TaskColumnStore::no_datetime;
+    }
+} // anonymous namespace
+
+TaskColumnStore::TaskColumnStore(const TreeItemModel* model, QObject* parent)
+    : QObject{parent}, model(model)
+{
+    connect(model, &TreeItemModel::item_created,    this, &TaskColumnStore::add_task);
+    connect(model, &TreeItemModel::items_destroyed, this, &TaskColumnStore::remove_tasks);
+    connect(model, &TreeItemModel::item_changed,    this, &TaskColumnStore::update_task);
+    connect(model, &TreeItemModel::modelReset,      this, &TaskColumnStore::rebuild);
+    this->rebuild();
+}
+
+void TaskColumnStore::add_task(const TaskId& task) {
+    qsizetype number = static_cast<qsizetype>(this->statuses.size());
+    if (this->free_numbers.empty()) {
+        this->statuses.push_back(Task::Status::open);
+        this->start_datetimes.push_back(no_datetime);
+        this->due_datetimes.push_back(no_datetime);
+        this->resolve_datetimes.push_back(no_datetime);
+        this->tag_sets.emplace_back();
+    } else {
+        number = this->free_numbers.back();
+        this->free_numbers.pop_back();
+    }
+    this->numbers.insert(task, number);
+    this->update_columns(number, task);
+}
+
+void TaskColumnStore::remove_tasks(const QList<TaskId>& tasks) {
+    for (const auto& task : tasks) {
+        const auto number = this->numbers.find(task);
+        if (number == this->numbers.end()) {
+            continue;
+        }
+        this->free_numbers.push_back(*number);
+        this->numbers.erase(number);
+    }
+}
+
+void TaskColumnStore::update_task(const TaskId& task, const QList<int>& roles) {
+    if (
+        !roles.isEmpty()
+        && !roles.contains(ActiveRole)
+        && !roles.contains(StartRole)
+        && !roles.contains(DueRole)
+        && !roles.contains(ResolveRole)
+        && !roles.contains(TagsRole)
+        && !roles.contains(AddTagRole)
+        && !roles.contains(RemoveTagRole)
+    ) {
+        return;
+    }
+    const auto number = this->get_number(task);
+    if (number != unknown_number) {
+        this->update_columns(number, task);
+    }
+}
+
+void TaskColumnStore::update_columns(qsizetype number, const TaskId& task) {
+    this->statuses[number]          = this->model->data(task, ActiveRole).value<Task::Status>();
+    this->start_datetimes[number]   = to_column_value(this->model->data(task, StartRole).toDateTime());
+    this->due_datetimes[number]     = to_column_value(this->model->data(task, DueRole).toDateTime());
+    this->resolve_datetimes[number] = to_column_value(this->model->data(task, ResolveRole).toDateTime());
+    this->tag_sets[number]          = this->tag_numbering.assign_bitset(this->model->data(task, TagsRole).value<QSet<TagId>>());
+}
+
+void TaskColumnStore::rebuild() {
+    this->numbers.clear();
+    this->free_numbers.clear();
+    this->statuses.clear();
+    this->start_datetimes.clear();
+    this->due_datetimes.clear();
+    this->resolve_datetimes.clear();
+    this->tag_sets.clear();
+    for (const auto& task : this->model->get_item_ids()) {
+        this->add_task(task);
+    }
+}
+
+/**
+ * @brief Returns the number indexing the columns of a task or unknown_number.
+ */
+qsizetype TaskColumnStore::get_number(const TaskId& task) const {
+    return this->numbers.value(task, unknown_number);
+}
+
+std::span<const Task::Status> TaskColumnStore::get_statuses() const {
+    return this->statuses;
+}
+
+std::span<const qint64> TaskColumnStore::get_start_datetimes() const {
+    return this->start_datetimes;
+}
+
+std::span<const qint64> TaskColumnStore::get_due_datetimes() const {
+    return this->due_datetimes;
+}
+
+std::span<const qint64> TaskColumnStore::get_resolve_datetimes() const {
+    return this->resolve_datetimes;
+}
+
+/**
+ * @brief Evaluate a status condition for all tasks at once.
+ *
+ * The loop has no branches and works on contiguous bytes, so that the compiler can
+ * vectorize it.
+ *
+ * @return one byte per task number; 1 if the task has the given status, 0 otherwise
+ */
+std::vector<quint8> TaskColumnStore::get_status_mask(Task::Status status) const {
+    std::vector<quint8> mask(this->statuses.size());
+    std::ranges::transform(
+        this->statuses,
+        mask.begin(),
+        [status](Task::Status task_status) { return static_cast<quint8>(task_status == status); }
+    );
+    return mask;
+}
+
+std::span<const DenseBitset> TaskColumnStore::get_tag_sets() const {
+    return this->tag_sets;
+}
+
+/**
+ * @brief The numbering of the tags in the bitsets returned by get_tag_sets.
+ */
+const TagNumbering& TaskColumnStore::get_tag_numbering() const {
+    return this->tag_numbering;
+}
+
+qsizetype TaskColumnStore::get_size() const {
+    return this->numbers.size();
+}
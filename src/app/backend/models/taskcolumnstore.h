@@ -0,0 +1,105 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <limits>
+#include <span>
+#include <vector>
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QtTypes>
+
+#include "dataitems/qtdid.h"
+#include "dataitems/task.h"
+#include "tagnumbering.h"
+#include "treeitemmodel.h"
+#include "utils/densebitset.h"
+
+/**
+ * @brief The scalar fields of the tasks of a model, stored column by column.
+ *
+ * Every task is assigned a dense number that indexes the columns; the numbers of removed
+ * tasks are reused. The tags of a task are stored as a bitset over dense tag numbers.
+ * Filters on these fields can thus be evaluated for all tasks at once by simple loops
+ * over contiguous arrays instead of one QVariant per model row.
+ *
+ * Like the TaskSearchIndex, the store follows the changes of the items of the model via
+ * its signals and reads the items by their ids, without creating tree nodes.
+ * Proxy models that query the store have to connect to the model after the store was
+ * created; that way, the store is up to date before they are notified of a change.
+ */
+class TaskColumnStore : public QObject
+{
+    Q_OBJECT
+
+public:
+    static constexpr qsizetype unknown_number = -1;
+
+    /**
+     * @brief Stored instead of the milliseconds since epoch if a date is not set
+     */
+    static constexpr qint64 no_datetime = std::numeric_limits<qint64>::min();
+
+    /**
+     * @brief A condition on the status of a task or of a related task.
+     */
+    struct Filter {
+        enum class Scope : quint8 {
+            task,              // The status of the task itself
+            leaf_task,         // The status of the task, which must not have children
+            top_level_ancestor // The status of the top level ancestor of the task
+        };
+
+        Task::Status status;
+        Scope scope = Scope::task;
+    };
+
+private:
+    const TreeItemModel* model;
+    QHash<TaskId, qsizetype> numbers;
+    std::vector<qsizetype> free_numbers;
+
+    std::vector<Task::Status> statuses;
+    std::vector<qint64> start_datetimes;
+    std::vector<qint64> due_datetimes;
+    std::vector<qint64> resolve_datetimes;
+    std::vector<DenseBitset> tag_sets;
+    TagNumbering tag_numbering;
+
+    void add_task(const TaskId& task);
+    void remove_tasks(const QList<TaskId>& tasks);
+    void update_task(const TaskId& task, const QList<int>& roles);
+    void update_columns(qsizetype number, const TaskId& task);
+    void rebuild();
+
+public:
+    explicit TaskColumnStore(const TreeItemModel* model, QObject* parent = nullptr);
+
+    [[nodiscard]] qsizetype get_number(const TaskId& task) const;
+    [[nodiscard]] std::span<const Task::Status> get_statuses() const;
+    [[nodiscard]] std::span<const qint64> get_start_datetimes() const;
+    [[nodiscard]] std::span<const qint64> get_due_datetimes() const;
+    [[nodiscard]] std::span<const qint64> get_resolve_datetimes() const;
+    [[nodiscard]] std::vector<quint8> get_status_mask(Task::Status status) const;
+    [[nodiscard]] std::span<const DenseBitset> get_tag_sets() const;
+    [[nodiscard]] const TagNumbering& get_tag_numbering() const;
+    [[nodiscard]] qsizetype get_size() const;
+};
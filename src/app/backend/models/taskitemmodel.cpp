@@ -18,40 +18,42 @@
 
 #include "taskitemmodel.h"
 
+#include <algorithm>
+#include <functional>
+#include <iterator>
 #include <memory>
 #include <utility>
+#include <vector>
 
 #include <QList>
 #include <QModelIndexList>
 #include <QMultiHash>
 #include <QObject>
+#include <QPair>
 #include <QSet>
-#include <QtConcurrentMap>
+#include <QString>
+#include <QVariant>
 
 #include "dataitems/qtdid.h"
 #include "dataitems/qtditemdatarole.h"
 #include "dataitems/task.h"
+#include "dataitems/uniquedataitem.h"
+#include "repositories/persistencequeue.h"
+#include "repositories/startuploader.h"
 #include "repositories/taskrepository.h"
+#include "tasksearchindex.h"
 #include "treeitemmodel.h"
 #include "utils/containerutils.h"
 
 void TaskItemModel::setup_tasks_from_db() {
-    auto task_repository = TaskRepository::create(this->connection_name);
-    auto dependents = task_repository.get_all_dependencies();
-    auto tag_assignments = task_repository.get_all_tag_assignments();
-
-    for (auto& task : task_repository.get_all_tasks()) {
-        auto task_uuid = task.get_data(UuidRole).value<TaskId>();
-        task.set_tags(tag_assignments[task_uuid]);
-        auto [parents_iterator, parents_end] = dependents.equal_range(task_uuid);
-        this->create_tree_node(
-            std::make_unique<Task>(std::move(task)),
-            parents_iterator == dependents.end() ? TaskId() : *(parents_iterator++)
-        );
-        while (parents_iterator != parents_end) {
-            this->clone_tree_node(task_uuid, *(parents_iterator++));
-        }
-    }
+    this->build_tree(StartupLoader::load_tasks(this->connection_name));
+}
+
+void TaskItemModel::build_tree(StartupLoader::TaskData task_data) {
+    std::vector<std::unique_ptr<UniqueDataItem>> data_items;
+    data_items.reserve(task_data.tasks.size());
+    std::ranges::move(task_data.tasks, std::back_inserter(data_items));
+    this->load_tree(std::move(data_items), task_data.dependencies);
 }
 
 QString TaskItemModel::get_sql_column_name(int role) {
@@ -69,6 +71,16 @@ TaskItemModel::TaskItemModel(QString connection_name, QObject* parent)
     : TreeItemModel(parent), connection_name(std::move(connection_name))
 {
     this->setup_tasks_from_db();
+    this->search_index = std::make_unique<TaskSearchIndex>(this);
+    this->column_store = std::make_unique<TaskColumnStore>(this);
+}
+
+TaskItemModel::TaskItemModel(QString connection_name, StartupLoader::TaskData task_data, QObject* parent)
+    : TreeItemModel(parent), connection_name(std::move(connection_name))
+{
+    this->build_tree(std::move(task_data));
+    this->search_index = std::make_unique<TaskSearchIndex>(this);
+    this->column_store = std::make_unique<TaskColumnStore>(this);
 }
 
 bool TaskItemModel::create_task(const QString& title, const QModelIndexList& parents) {
@@ -79,27 +91,34 @@ bool TaskItemModel::create_task(const QString& title, const QModelIndexList& par
         [](const QModelIndex& index){ return index.data(UuidRole); }
     );
 
-    auto task_repository = TaskRepository::create(this->connection_name);
-
-    if (
-           !task_repository.save(*new_task)
-        || !task_repository.add_dependents(new_task_uuid, parent_uuids)
-    ) {
-        task_repository.roll_back();
-        return false;
-    }
+    const auto task_title = new_task->get_title();
+    return this->persist_change(
+        [task_title, new_task_uuid, parent_uuids](const TaskRepository& task_repository) {
+            const Task task(task_title, Task::Status::open, {}, {}, {}, "", new_task_uuid.toString());
+            return task_repository.save(task)
+                   && task_repository.add_dependents(new_task_uuid, parent_uuids);
+        },
+        [this, &new_task, &parent_uuids]() {
+            return this->add_task_to_tree(std::move(new_task), parent_uuids);
+        }
+    );
+}
 
+/**
+ * @brief Insert a new task below all given parents; the first parent receives the original node.
+ */
+bool TaskItemModel::add_task_to_tree(std::unique_ptr<Task> task, const QList<QVariant>& parent_uuids) {
+    const auto task_uuid = task->get_uuid();
     auto parents_iterator = parent_uuids.begin();
     bool success = this->create_tree_node(
-        std::move(new_task),
+        std::move(task),
         parents_iterator == parent_uuids.end() ? TaskId() : (parents_iterator++)->value<TaskId>()
     );
     while (parents_iterator != parent_uuids.end()) {
-        success &= this->clone_tree_node(new_task_uuid, parents_iterator->value<TaskId>());
+        success &= this->clone_tree_node(task_uuid, parents_iterator->value<TaskId>());
         ++parents_iterator;
     }
-
-    return task_repository.roll_back_on_failure(success);
+    return success;
 }
 
 bool TaskItemModel::setData(const QModelIndex& index, const QVariant& value, int role) {
@@ -111,19 +130,18 @@ bool TaskItemModel::setData(const QModelIndex& index, const QVariant& value, int
         return false;
     }
 
-    auto task_repository = TaskRepository::create(this->connection_name);
-    const bool success = task_repository.update_column(
-        index.data(UuidRole).value<TaskId>(),
-        column_name,
-        (role == ActiveRole) ? Task::status_to_string(value.value<Task::Status>()) : value
-    );
-    return task_repository.roll_back_on_failure(
-        success && TreeItemModel::setData(index, value, role)
+    const auto task_uuid = index.data(UuidRole).value<TaskId>();
+    const auto sql_value = (role == ActiveRole) ? Task::status_to_string(value.value<Task::Status>()) : value;
+    return this->persist_change(
+        [task_uuid, column_name, sql_value](const TaskRepository& task_repository) {
+            return task_repository.update_column(task_uuid, column_name, sql_value);
+        },
+        [this, &index, &value, role]() { return TreeItemModel::setData(index, value, role); },
+        task_uuid.toString() + '/' + column_name
     );
 }
 
 bool TaskItemModel::removeRows(int row, int count, const QModelIndex &parent) {
-    auto task_repository = TaskRepository::create(this->connection_name);
     auto parent_uuid = parent.isValid() ? parent.data(UuidRole).value<TaskId>() : TaskId();
 
     QList<QVariant> task_ids(count);
@@ -131,9 +149,46 @@ bool TaskItemModel::removeRows(int row, int count, const QModelIndex &parent) {
         task_ids[i-row] = this->index(i, 0, parent).data(UuidRole);
     }
 
-    return task_repository.roll_back_on_failure(
-        task_repository.remove_prerequisites(parent_uuid, task_ids)
-        && TreeItemModel::removeRows(row, count, parent)
+    return this->persist_change(
+        [parent_uuid, task_ids](const TaskRepository& task_repository) {
+            return task_repository.remove_prerequisites(parent_uuid, task_ids);
+        },
+        [this, row, count, &parent]() { return TreeItemModel::removeRows(row, count, parent); }
+    );
+}
+
+/**
+ * @brief Remove several tasks from their dependents, see TreeItemModel::remove_items.
+ *
+ * All removed dependencies are deleted from the database in one batch and transaction.
+ */
+bool TaskItemModel::remove_items(const QModelIndexList& indexes) {
+    QSet<QPair<TaskId, TaskId>> dependencies;
+    for (const auto& index : indexes) {
+        if (!this->checkIndex(index, CheckIndexOption::IndexIsValid)) {
+            return false;
+        }
+        const auto parent = index.parent();
+        dependencies.insert({
+            parent.isValid() ? parent.data(UuidRole).value<TaskId>() : TaskId(),
+            index.data(UuidRole).value<TaskId>()
+        });
+    }
+
+    QList<QVariant> dependents;
+    QList<QVariant> prerequisites;
+    dependents.reserve(dependencies.size());
+    prerequisites.reserve(dependencies.size());
+    for (const auto& [dependent, prerequisite] : std::as_const(dependencies)) {
+        dependents << dependent;
+        prerequisites << prerequisite;
+    }
+
+    return this->persist_change(
+        [dependents, prerequisites](const TaskRepository& task_repository) {
+            return task_repository.remove_dependencies(dependents, prerequisites);
+        },
+        [this, &indexes]() { return TreeItemModel::remove_items(indexes); }
     );
 }
 
@@ -156,18 +211,14 @@ bool TaskItemModel::add_dependency(
     }
 
     const auto dependent_uuid = dependent.data(UuidRole).value<TaskId>();
-    auto task_repository = TaskRepository::create(this->connection_name);
-
-    return task_repository.roll_back_on_failure(
-        task_repository.add_prerequisites(
-            dependent_uuid,
-            { prerequisite.data(UuidRole) }
-        )
-        &&
-        this->clone_tree_node(
-            prerequisite.data(UuidRole).value<TaskId>(),
-            dependent_uuid
-        )
+    const auto prerequisite_uuid = prerequisite.data(UuidRole).value<TaskId>();
+    return this->persist_change(
+        [dependent_uuid, prerequisite_uuid](const TaskRepository& task_repository) {
+            return task_repository.add_prerequisites(dependent_uuid, {QVariant::fromValue(prerequisite_uuid)});
+        },
+        [this, &dependent_uuid, &prerequisite_uuid]() {
+            return this->clone_tree_node(prerequisite_uuid, dependent_uuid);
+        }
     );
 }
 
@@ -188,10 +239,12 @@ bool TaskItemModel::add_tag(
     if (!index.isValid()) {
         return false;
     }
-    auto task_repository = TaskRepository::create(this->connection_name);
-    return task_repository.roll_back_on_failure(
-        task_repository.add_tag(index.data(UuidRole).value<TaskId>(), tag)
-        && TreeItemModel::setData(index, tag, AddTagRole)
+    const auto task_uuid = index.data(UuidRole).value<TaskId>();
+    return this->persist_change(
+        [task_uuid, tag](const TaskRepository& task_repository) {
+            return task_repository.add_tag(task_uuid, tag);
+        },
+        [this, &index, &tag]() { return TreeItemModel::setData(index, tag, AddTagRole); }
     );
 }
 
@@ -212,9 +265,127 @@ bool TaskItemModel::remove_tag(
     if (!(index.isValid() && index.data(TagsRole).value<QSet<TagId>>().contains(tag))) {
         return false;
     }
-    auto task_repository = TaskRepository::create(this->connection_name);
-    return task_repository.roll_back_on_failure(
-        task_repository.remove_tag(index.data(UuidRole).value<TaskId>(), tag)
-        && TreeItemModel::setData(index, tag, RemoveTagRole)
+    const auto task_uuid = index.data(UuidRole).value<TaskId>();
+    return this->persist_change(
+        [task_uuid, tag](const TaskRepository& task_repository) {
+            return task_repository.remove_tag(task_uuid, tag);
+        },
+        [this, &index, &tag]() { return TreeItemModel::setData(index, tag, RemoveTagRole); }
+    );
+}
+
+/**
+ * @brief Assign every tag to every task at once; see add_tag.
+ *
+ * Assignments that already exist are skipped. The remaining ones are written in a single
+ * batch and the changes are announced with one dataChanged signal per range of changed rows.
+ *
+ * @return false without any change if one of the indexes is invalid
+ */
+bool TaskItemModel::add_tags(const QModelIndexList& indexes, const QList<TagId>& tags) {
+    return this->change_tags(indexes, tags, AddTagRole);
+}
+
+/**
+ * @brief Remove every tag from every task at once; see remove_tag and add_tags.
+ */
+bool TaskItemModel::remove_tags(const QModelIndexList& indexes, const QList<TagId>& tags) {
+    return this->change_tags(indexes, tags, RemoveTagRole);
+}
+
+bool TaskItemModel::change_tags(const QModelIndexList& indexes, const QList<TagId>& tags, int role) {
+    const bool add = (role == AddTagRole);
+    const QSet<TagId> distinct_tags(tags.cbegin(), tags.cend());
+    QSet<TaskId> visited_tasks;
+    QList<QVariant> task_column;
+    QList<QVariant> tag_column;
+    for (const auto& index : indexes) {
+        if (!this->checkIndex(index, CheckIndexOption::IndexIsValid)) {
+            return false;
+        }
+        const auto task = index.data(UuidRole).value<TaskId>();
+        if (visited_tasks.contains(task)) {
+            continue; // A clone of an already processed task
+        }
+        visited_tasks.insert(task);
+
+        const auto assigned_tags = index.data(TagsRole).value<QSet<TagId>>();
+        for (const auto& tag : distinct_tags) {
+            if (assigned_tags.contains(tag) != add) {
+                task_column << task;
+                tag_column << tag;
+            }
+        }
+    }
+    if (task_column.isEmpty()) {
+        return true;
+    }
+
+    return this->persist_change(
+        [add, task_column, tag_column](const TaskRepository& task_repository) {
+            return add
+                ? task_repository.add_tags(task_column, tag_column)
+                : task_repository.remove_tags(task_column, tag_column);
+        },
+        [this, &task_column, &tag_column, role]() {
+            return TreeItemModel::set_data_of_items(task_column, tag_column, role);
+        }
+    );
+}
+
+const TaskSearchIndex* TaskItemModel::get_search_index() const {
+    return this->search_index.get();
+}
+
+const TaskColumnStore* TaskItemModel::get_column_store() const {
+    return this->column_store.get();
+}
+
+/**
+ * @brief Switch to write-behind mode; passing nullptr restores synchronous persistence.
+ *
+ * In write-behind mode, all modifying operations alter the model immediately and leave
+ * persisting the change to the queue. If the queue fails to write some of the changes,
+ * the model is reloaded from the database; this reverts the failed changes, while all
+ * other changes have been written, see PersistenceQueue.
+ */
+void TaskItemModel::set_persistence_queue(PersistenceQueue* persistence_queue) {
+    if (this->persistence_queue != nullptr) {
+        this->persistence_queue->flush();
+        this->persistence_queue->disconnect(this);
+    }
+    this->persistence_queue = persistence_queue;
+    if (persistence_queue != nullptr) {
+        connect(
+            persistence_queue, &PersistenceQueue::flush_failed,
+            this, &TaskItemModel::reload_from_db
+        );
+    }
+}
+
+/**
+ * @brief Replace the tasks by the content of the database after a batch of changes failed.
+ *
+ * The queue reports a failure only after all operations queued until then have been
+ * written, so the reloaded tasks are not overwritten afterwards.
+ */
+void TaskItemModel::reload_from_db() {
+    this->setup_tasks_from_db();
+}
+
+/**
+ * @brief Apply a change to the tree and persist it, see PersistenceQueue::apply_and_persist.
+ */
+bool TaskItemModel::persist_change(
+    const std::function<bool(const TaskRepository&)>& operation,
+    const std::function<bool()>& change_tree,
+    const QString& coalescing_key
+) {
+    return PersistenceQueue::apply_and_persist<TaskRepository>(
+        this->persistence_queue.data(),
+        this->connection_name,
+        operation,
+        change_tree,
+        coalescing_key
     );
 }
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -18,13 +18,25 @@
 
 #pragma once
 
+#include <functional>
+#include <memory>
+
 #include <QList>
 #include <QModelIndex>
+#include <QModelIndexList>
 #include <QMultiHash>
 #include <QObject>
+#include <QPointer>
 #include <QString>
+#include <QVariant>
 
 #include "dataitems/qtdid.h"
+#include "dataitems/task.h"
+#include "repositories/persistencequeue.h"
+#include "repositories/startuploader.h"
+#include "repositories/taskrepository.h"
+#include "taskcolumnstore.h"
+#include "tasksearchindex.h"
 #include "treeitemmodel.h"
 
 class TaskItemModel : public TreeItemModel
@@ -33,17 +45,36 @@ class TaskItemModel : public TreeItemModel
 
 private:
     QString connection_name;
+    std::unique_ptr<TaskSearchIndex> search_index;
+    std::unique_ptr<TaskColumnStore> column_store;
+    QPointer<PersistenceQueue> persistence_queue;
 
     void setup_tasks_from_db();
+    void build_tree(StartupLoader::TaskData task_data);
+    bool add_task_to_tree(std::unique_ptr<Task> task, const QList<QVariant>& parent_uuids);
+    bool change_tags(const QModelIndexList& indexes, const QList<TagId>& tags, int role);
+    bool persist_change(
+        const std::function<bool(const TaskRepository&)>& operation,
+        const std::function<bool()>& change_tree,
+        const QString& coalescing_key = ""
+    );
     static QString get_sql_column_name(int role);
 
 public:
     explicit TaskItemModel(QString connection_name, QObject* parent = nullptr);
+    TaskItemModel(QString connection_name, StartupLoader::TaskData task_data, QObject* parent = nullptr);
 
     bool setData(const QModelIndex& index, const QVariant& value, int role) override;
     Q_INVOKABLE bool create_task(const QString& title, const QModelIndexList& parents = {});
     bool removeRows(int row, int count, const QModelIndex& parent) override;
+    Q_INVOKABLE bool remove_items(const QModelIndexList& indexes) override;
     bool add_dependency(const QModelIndex& dependent, const QModelIndex& prerequisite);
     bool add_tag(const QModelIndex& index, const TagId& tag);
     bool remove_tag(const QModelIndex& index, const TagId& tag);
+    bool add_tags(const QModelIndexList& indexes, const QList<TagId>& tags);
+    bool remove_tags(const QModelIndexList& indexes, const QList<TagId>& tags);
+    [[nodiscard]] const TaskSearchIndex* get_search_index() const;
+    [[nodiscard]] const TaskColumnStore* get_column_store() const;
+    void set_persistence_queue(PersistenceQueue* persistence_queue);
+    void reload_from_db();
 };
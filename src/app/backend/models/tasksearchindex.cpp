@@ -0,0 +1,172 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "tasksearchindex.h"
+
+#include <algorithm>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+
+#include "dataitems/qtdid.h"
+#include "dataitems/qtditemdatarole.h"
+#include "treeitemmodel.h"
+
+namespace {
+    constexpr qsizetype trigram_length = 3;
+} // anonymous namespace
+
+TaskSearchIndex::TaskSearchIndex(const TreeItemModel* model, QObject* parent)
+    : QObject{parent}, model(model)
+{
+    connect(model, &TreeItemModel::item_created,    this, &TaskSearchIndex::add_task);
+    connect(model, &TreeItemModel::items_destroyed, this, &TaskSearchIndex::remove_tasks);
+    connect(model, &TreeItemModel::item_changed,    this, &TaskSearchIndex::update_search_text);
+    connect(model, &TreeItemModel::modelReset,      this, &TaskSearchIndex::rebuild);
+    this->rebuild();
+}
+
+QSet<TaskSearchIndex::Trigram> TaskSearchIndex::get_trigrams(const QString& text) {
+    QSet<Trigram> trigrams;
+    for (qsizetype i=0; i+trigram_length<=text.size(); i++) {
+        trigrams.insert(
+              (static_cast<Trigram>(text.at(i).unicode()) << 32U)
+            | (static_cast<Trigram>(text.at(i + 1).unicode()) << 16U)
+            |  static_cast<Trigram>(text.at(i + 2).unicode())
+        );
+    }
+    return trigrams;
+}
+
+void TaskSearchIndex::add_postings(const TaskId& task, const QString& search_text) {
+    for (const auto trigram : TaskSearchIndex::get_trigrams(search_text)) {
+        this->postings[trigram].insert(task);
+    }
+}
+
+void TaskSearchIndex::remove_postings(const TaskId& task, const QString& search_text) {
+    for (const auto trigram : TaskSearchIndex::get_trigrams(search_text)) {
+        const auto posting = this->postings.find(trigram);
+        if (posting == this->postings.end()) {
+            continue;
+        }
+        posting->remove(task);
+        if (posting->isEmpty()) {
+            this->postings.erase(posting);
+        }
+    }
+}
+
+void TaskSearchIndex::add_task(const TaskId& task) {
+    const auto search_text = this->model->data(task, SearchTextRole).toString();
+    this->search_texts.insert(task, search_text);
+    this->add_postings(task, search_text);
+}
+
+void TaskSearchIndex::remove_tasks(const QList<TaskId>& tasks) {
+    for (const auto& task : tasks) {
+        const auto search_text = this->search_texts.find(task);
+        if (search_text == this->search_texts.end()) {
+            continue;
+        }
+        this->remove_postings(task, *search_text);
+        this->search_texts.erase(search_text);
+    }
+}
+
+void TaskSearchIndex::update_search_text(const TaskId& task, const QList<int>& roles) {
+    if (
+        !roles.isEmpty()
+        && !roles.contains(Qt::DisplayRole)
+        && !roles.contains(DetailsRole)
+        && !roles.contains(SearchTextRole)
+    ) {
+        return;
+    }
+    const auto entry = this->search_texts.find(task);
+    if (entry == this->search_texts.end()) {
+        return;
+    }
+    auto search_text = this->model->data(task, SearchTextRole).toString();
+    if (search_text == *entry) {
+        return;
+    }
+    this->remove_postings(task, *entry);
+    this->add_postings(task, search_text);
+    *entry = std::move(search_text);
+}
+
+void TaskSearchIndex::rebuild() {
+    this->search_texts.clear();
+    this->postings.clear();
+    for (const auto& task : this->model->get_item_ids()) {
+        this->add_task(task);
+    }
+}
+
+/**
+ * @brief Find all tasks whose search text may contain all given words.
+ *
+ * The result is a superset of the matching tasks: words are only checked for
+ * their trigrams. Words shorter than a trigram can not be looked up; if no word
+ * is long enough, std::nullopt is returned and every task has to be considered.
+ *
+ * @param case_folded_words the search words, already case folded
+ */
+std::optional<QSet<TaskId>> TaskSearchIndex::find_candidates(const QStringList& case_folded_words) const {
+    std::vector<const QSet<TaskId>*> word_postings;
+    for (const auto& word : case_folded_words) {
+        for (const auto trigram : TaskSearchIndex::get_trigrams(word)) {
+            const auto posting = this->postings.constFind(trigram);
+            if (posting == this->postings.cend()) {
+                return QSet<TaskId>();
+            }
+            word_postings.push_back(&posting.value());
+        }
+    }
+    if (word_postings.empty()) {
+        return std::nullopt;
+    }
+
+    std::ranges::sort(
+        word_postings,
+        [](const QSet<TaskId>* lhs, const QSet<TaskId>* rhs) { return lhs->size() < rhs->size(); }
+    );
+    QSet<TaskId> candidates;
+    for (const auto& task : *word_postings.front()) {
+        const bool in_all_postings = std::all_of(
+            word_postings.begin() + 1,
+            word_postings.end(),
+            [&task](const QSet<TaskId>* posting) { return posting->contains(task); }
+        );
+        if (in_all_postings) {
+            candidates.insert(task);
+        }
+    }
+    return candidates;
+}
+
+qsizetype TaskSearchIndex::get_size() const {
+    return this->search_texts.size();
+}
@@ -0,0 +1,69 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <optional>
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QSet>
+#include <QString>
+#include <QStringList>
+#include <QtTypes>
+
+#include "dataitems/qtdid.h"
+#include "treeitemmodel.h"
+
+/**
+ * @brief An in-memory trigram index over the search text of the tasks of a model.
+ *
+ * The index follows the changes of the items of the model via its signals; it reads the
+ * items by their ids, so that no tree nodes are created. Proxy models that query the
+ * index have to connect to the model after the index was created; that way, the index
+ * is up to date before they are notified of a change.
+ */
+class TaskSearchIndex : public QObject
+{
+    Q_OBJECT
+
+private:
+    /**
+     * @brief Three consecutive UTF-16 code units packed into one integer
+     */
+    using Trigram = quint64;
+
+    const TreeItemModel* model;
+    QHash<TaskId, QString> search_texts;
+    QHash<Trigram, QSet<TaskId>> postings;
+
+    [[nodiscard]] static QSet<Trigram> get_trigrams(const QString& text);
+    void add_postings(const TaskId& task, const QString& search_text);
+    void remove_postings(const TaskId& task, const QString& search_text);
+    void add_task(const TaskId& task);
+    void remove_tasks(const QList<TaskId>& tasks);
+    void update_search_text(const TaskId& task, const QList<int>& roles);
+    void rebuild();
+
+public:
+    explicit TaskSearchIndex(const TreeItemModel* model, QObject* parent = nullptr);
+
+    [[nodiscard]] std::optional<QSet<TaskId>> find_candidates(const QStringList& case_folded_words) const;
+    [[nodiscard]] qsizetype get_size() const;
+};
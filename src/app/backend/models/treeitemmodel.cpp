@@ -18,185 +18,393 @@
 
 #include "treeitemmodel.h"
 
-#include <functional>
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
 #include <memory>
+#include <numeric>
 #include <stack>
 #include <utility>
+#include <vector>
 
 #include <QAbstractItemModel>
+#include <QHash>
 #include <QList>
+#include <QMetaObject>
+#include <QModelIndexList>
 #include <QObject>
+#include <QPair>
+#include <QSet>
+#include <QVariant>
 #include <QtTypes>
 
+#include "dataitems/graphnode.h"
 #include "dataitems/qtdid.h"
-#include "dataitems/qtditemdatarole.h"
 #include "dataitems/treenode.h"
 #include "dataitems/uniquedataitem.h"
+#include "utils/objectpool.h"
 
 namespace {
 
 /**
- * @brief Traverse a node hierarchy in depth first order and execute a function on each element.
- *
- * The passed function must return a boolean that indicates if the foreach loop should be
- * aborted. If the return value is false, the foreach loop continues. If the return value
- * is true, the foreach loop is stopped.
- *
- * @param node the top level node of the hierarchy to process
- * @param operation the function to execute on each node
- * @return the node on which the loop was aborted or nullptr if the loop finished
+ * @brief Order items such that every item precedes its children (Kahn's algorithm).
+ * @param children the positions of the children of every item
+ * @return the positions of the items in topological order; incomplete if the relations contain a cycle
  */
-
-const TreeNode* tree_nodes_foreach(
-    TreeNode* node,
-    const std::function<bool(TreeNode*)>& operation
-) {
-    std::stack<TreeNode*> to_be_visited;
-    to_be_visited.push(node);
-
-    while (!to_be_visited.empty()) {
-        auto* current_node = to_be_visited.top();
-        to_be_visited.pop();
-        if (operation(current_node)) {
-            return current_node;
+std::vector<std::size_t> get_topological_order(const std::vector<std::vector<std::size_t>>& children) {
+    std::vector<std::size_t> parent_counts(children.size(), 0);
+    for (const auto& item_children : children) {
+        for (const auto child : item_children) {
+            ++parent_counts[child];
         }
+    }
 
-        for (int i=current_node->get_child_count()-1; i>=0; i--) {
-            to_be_visited.push(current_node->get_child(i));
+    std::vector<std::size_t> result;
+    result.reserve(children.size());
+    for (std::size_t position=0; position<children.size(); ++position) {
+        if (parent_counts[position] == 0) {
+            result.push_back(position);
+        }
+    }
+    // The result doubles as the queue of items whose parents have all been visited:
+    for (std::size_t next=0; next<result.size(); ++next) {
+        for (const auto child : children[result[next]]) {
+            if (--parent_counts[child] == 0) {
+                result.push_back(child);
+            }
         }
     }
-    return nullptr;
+    return result;
 }
 
-bool tree_node_has_nested_child_with_uuid(TreeNode* node, const QtdId& uuid) {
-    const auto* node_with_matching_uuid
-        = tree_nodes_foreach(
-            node,
-            [&uuid](TreeNode* node) {
-                return node->get_data(UuidRole).value<QtdId>() == uuid;
+/**
+ * @brief Collect the graph nodes reachable from a node via children or via parents whose
+ *        topological ranks lie within the given bounds.
+ * @param start the node to start at; it is always part of the result
+ * @param follow_children whether to follow the children (true) or the parents (false)
+ * @param forbidden_node a node that must not be reached
+ * @return the visited nodes or an empty list if the forbidden node was reached
+ */
+std::vector<GraphNode*> collect_affected_nodes(
+    GraphNode* start,
+    bool follow_children,
+    qsizetype lower_rank,
+    qsizetype upper_rank,
+    const GraphNode* forbidden_node = nullptr
+) {
+    std::vector<GraphNode*> result{start};
+    QSet<const GraphNode*> visited{start};
+    std::stack<GraphNode*> to_be_visited;
+    to_be_visited.push(start);
+
+    const auto visit = [&](GraphNode* node) {
+        const auto rank = node->get_topological_rank();
+        if (rank < lower_rank || rank > upper_rank || visited.contains(node)) {
+            return true;
+        }
+        if (node == forbidden_node) {
+            return false;
+        }
+        visited.insert(node);
+        result.push_back(node);
+        to_be_visited.push(node);
+        return true;
+    };
+    while (!to_be_visited.empty()) {
+        const auto* current_node = to_be_visited.top();
+        to_be_visited.pop();
+        if (follow_children) {
+            for (int row=0; row<current_node->get_child_count(); ++row) {
+                if (!visit(current_node->get_child(row))) {
+                    return {};
+                }
             }
-        );
-    return node_with_matching_uuid != nullptr;
+        } else {
+            for (auto* parent : current_node->get_parents()) {
+                visit(parent);
+            }
+        }
+    }
+    return result;
 }
 
-bool adding_node_creates_dependency_cycle(TreeNode* new_node, const QtdId& parent_uuid) {
-    return tree_node_has_nested_child_with_uuid(new_node, parent_uuid);
+/**
+ * @brief Count the paths from a graph node to itself and all of its descendants.
+ * @param node the graph node to start at
+ * @param counts memoized results for the graph nodes visited so far
+ */
+qsizetype count_paths(const GraphNode* node, QHash<const GraphNode*, qsizetype>& counts) {
+    const auto known_count = counts.constFind(node);
+    if (known_count != counts.cend()) {
+        return *known_count;
+    }
+
+    qsizetype result = 1;
+    for (int row=0; row<node->get_child_count(); ++row) {
+        result += count_paths(node->get_child(row), counts);
+    }
+    counts.insert(node, result);
+    return result;
 }
 
+/**
+ * @brief A changed child of a tree node together with its changed roles.
+ */
+struct ChangedRow {
+    int row;
+    QList<int> roles;
+};
+
 } // anonymous namespace
 
 TreeItemModel::TreeItemModel(QObject *parent)
     : QAbstractItemModel{parent}
 {
-    this->root = TreeNode::create(std::make_unique<UniqueDataItem>());
-    this->uuid_node_map.insert(
-        this->root->get_data(UuidRole).value<QtdId>(),
-        this->root.get()
-    );
+    this->clear();
+}
+
+TreeItemModel::~TreeItemModel() {
+    this->release_nodes();
+}
+
+/**
+ * @brief Remove all nodes from the model.
+ *
+ * Attached views are not notified; callers have to wrap this into a model reset.
+ */
+void TreeItemModel::clear() {
+    this->release_nodes();
+    this->root_graph_node = this->graph_node_pool.create(std::make_unique<UniqueDataItem>());
+    this->root = TreeNode::create(this->tree_node_pool, this->root_graph_node);
+    this->next_topological_rank = 1;
+}
+
+/**
+ * @brief Destroy all tree nodes and afterwards all graph nodes, the root included.
+ */
+void TreeItemModel::release_nodes() {
+    TreeNode::destroy(this->root);
+    this->root = nullptr;
+    for (auto* graph_node : std::as_const(this->graph_nodes)) {
+        this->graph_node_pool.destroy(graph_node);
+    }
+    this->graph_nodes.clear();
+    this->pending_changes.clear();
+    this->graph_node_pool.destroy(this->root_graph_node);
+    this->root_graph_node = nullptr;
 }
 
 QModelIndex TreeItemModel::create_index(const TreeNode *node) const {
-    return node == this->root.get()
+    return node == this->root
                 ? QModelIndex()
                 : this->createIndex(node->get_row_in_parent(), 0, node);
 }
 
 /**
- * @brief Invoke a function on all clones associated with the given ID
- * @param uuid The QtdId identifying the nodes to operate on
- * @param operation The function to execute
+ * @brief Returns the graph node with the given id, the root if the id is invalid
+ *        and nullptr if the id is unknown.
  */
-void TreeItemModel::operate_on_clones(
-    const QtdId& uuid,
-    const std::function<void(TreeNode*)>& operation
-) {
-    const QList<TreeNode*> clones = this->uuid_node_map.values(uuid);
-    for (auto *clone : clones) {
-        operation(clone);
-    }
+GraphNode* TreeItemModel::get_graph_node(const QtdId& uuid) const {
+    return uuid.is_valid()
+        ? this->graph_nodes.value(uuid)
+        : this->root_graph_node;
 }
 
 /**
- * @brief Convenience override; invoke a function on a node and all its clones
- * @param node_index the index specifying the node
- * @param operation The function to execute
+ * @brief Returns the id of a graph node as used by the signals, an invalid id for the root.
  */
-void TreeItemModel::operate_on_clones(
-    const QModelIndex& node_index,
-    const std::function<void(TreeNode*)>& operation
-) {
-    auto node_uuid = node_index.isValid()
-                    ? node_index.data(UuidRole).value<QtdId>()
-                    : this->root->get_data(UuidRole).value<QtdId>();
-    this->operate_on_clones(node_uuid, operation);
+QtdId TreeItemModel::get_item_id(const GraphNode* graph_node) const {
+    return graph_node == this->root_graph_node ? QtdId() : graph_node->get_uuid();
 }
 
 /**
- * @brief Adds a tree node as a child of all nodes associated with the given id
+ * @brief Collect the tree nodes of a graph node before changing its children.
  *
- * If the id is invalid, the tree node will be added without a parent (top level),
- * if the id is valid but unknown, the node is not created and the function returns
- * false.
+ * The number of children of every tree node is fixed beforehand, such that it still
+ * reflects the graph when the change is applied to the tree nodes one after another.
  *
- * @param new_node The tree node to add
- * @param parent_uuid The id identifying the parents of the new node
- * @return true if the tree node could be added to the model, false otherwise
+ * @param graph_node the graph node whose children are about to change
+ * @param excluded_tree_nodes tree nodes that have been updated already
  */
-bool TreeItemModel::add_tree_node(
-    std::unique_ptr<TreeNode> new_node,
-    const QtdId& parent_uuid
+std::vector<TreeNode*> TreeItemModel::prepare_tree_nodes(
+    const GraphNode* graph_node,
+    const QSet<const TreeNode*>& excluded_tree_nodes
 ) {
-    auto parent_or_root_uuid = parent_uuid.is_valid()
-                             ? parent_uuid
-                             : this->root->get_data(UuidRole).value<QtdId>();
+    std::vector<TreeNode*> result;
+    for (auto* tree_node : graph_node->get_tree_nodes()) {
+        if (!excluded_tree_nodes.contains(tree_node)) {
+            result.push_back(tree_node);
+        }
+    }
+    for (const auto* tree_node : result) {
+        tree_node->materialize_child_slots();
+    }
+    return result;
+}
 
-    if (!this->uuid_node_map.contains(parent_or_root_uuid)) {
+/**
+ * @brief Reorder the graph nodes such that a new edge from parent to child respects the
+ *        topological order, unless the edge would create a cycle (Pearce-Kelly algorithm).
+ *
+ * If the parent already precedes the child, nothing needs to be done. Otherwise, only the
+ * nodes ranked between child and parent are visited: the descendants of the child, which
+ * must not include the parent, and the ancestors of the parent. Both groups swap their
+ * places in the order and keep their internal order.
+ *
+ * @return false if the child is the parent or one of its ancestors
+ */
+bool TreeItemModel::update_topological_order(GraphNode* parent, GraphNode* child) {
+    const auto lower_rank = child->get_topological_rank();
+    const auto upper_rank = parent->get_topological_rank();
+    if (lower_rank > upper_rank) {
+        return true;
+    }
+    if (child == parent) {
         return false;
     }
 
-    if (adding_node_creates_dependency_cycle(new_node.get(), parent_uuid)) {
+    auto descendants = collect_affected_nodes(child, true, lower_rank, upper_rank, parent);
+    if (descendants.empty()) {
         return false;
     }
+    auto ancestors = collect_affected_nodes(parent, false, lower_rank, upper_rank);
+
+    const auto by_rank = [](const GraphNode* node, const GraphNode* other_node) {
+        return node->get_topological_rank() < other_node->get_topological_rank();
+    };
+    std::ranges::sort(descendants, by_rank);
+    std::ranges::sort(ancestors, by_rank);
+    std::vector<qsizetype> ranks;
+    ranks.reserve(descendants.size() + ancestors.size());
+    for (const auto* node : descendants) {
+        ranks.push_back(node->get_topological_rank());
+    }
+    for (const auto* node : ancestors) {
+        ranks.push_back(node->get_topological_rank());
+    }
+    std::ranges::sort(ranks);
 
-    const auto* new_node_raw_ptr = new_node.get();
-    this->operate_on_clones(
-        parent_or_root_uuid,
-        [this, new_node_raw_ptr](TreeNode* parent_node_ptr) -> void {
+    auto next_rank = ranks.begin();
+    for (auto* node : ancestors) {
+        node->set_topological_rank(*next_rank++);
+    }
+    for (auto* node : descendants) {
+        node->set_topological_rank(*next_rank++);
+    }
+    return true;
+}
 
-            this->beginInsertRows(
-                this->create_index(parent_node_ptr),
-                parent_node_ptr->get_child_count(),
-                parent_node_ptr->get_child_count()
-            );
+/**
+ * @brief Append a child to a graph node and insert it below all tree nodes of the parent.
+ */
+void TreeItemModel::add_graph_edge(GraphNode* parent, GraphNode* child) {
+    this->flush_changes();
+    const int row = parent->get_child_count();
+    const auto tree_nodes = TreeItemModel::prepare_tree_nodes(parent);
+    parent->add_child(child);
+
+    for (auto* tree_node : tree_nodes) {
+        this->beginInsertRows(this->create_index(tree_node), row, row);
+        tree_node->insert_children(row, 1);
+        this->endInsertRows();
+    }
+    emit this->relation_added(this->get_item_id(parent), child->get_uuid());
+}
 
-            auto node_clone = TreeNode::clone(new_node_raw_ptr, parent_node_ptr);
-            this->add_recursively_to_uuid_node_map(node_clone.get());
-            parent_node_ptr->add_child(std::move(node_clone));
+/**
+ * @brief Remove a child from a graph node. A child without remaining parents is
+ *        destroyed together with all descendants that are not referenced elsewhere.
+ *
+ * The corresponding tree nodes must have been removed already. The destroyed items and
+ * the removed relations to surviving children of destroyed items are recorded, so that
+ * they can be announced once the graph is consistent again.
+ */
+void TreeItemModel::remove_graph_edge(GraphNode* parent, int row, RemovedRelations& removed_relations) {
+    auto* child = parent->take_child(row);
+    if (!child->get_parents().empty()) {
+        return;
+    }
 
-            this->endInsertRows();
+    const auto uuid = child->get_uuid();
+    removed_relations.destroyed_items.append(uuid);
+    this->graph_nodes.remove(uuid);
+    this->pending_changes.remove(child);
+    for (int child_row=child->get_child_count()-1; child_row>=0; child_row--) {
+        const auto grandchild_uuid = child->get_child(child_row)->get_uuid();
+        this->remove_graph_edge(child, child_row, removed_relations);
+        if (this->graph_nodes.contains(grandchild_uuid)) {
+            removed_relations.children_by_parent[uuid].prepend(grandchild_uuid);
         }
-    );
-    return true;
+    }
+    this->graph_node_pool.destroy(child);
 }
 
-void TreeItemModel::add_recursively_to_uuid_node_map(TreeNode* node) {
-    tree_nodes_foreach(node, [this](TreeNode* node) {
-        this->uuid_node_map.insert(node->get_data(UuidRole).value<QtdId>(), node);
-        return false;
-    });
+/**
+ * @brief Remove the relations of a graph node to its children at the given rows.
+ *
+ * Every tree node of the parent is notified once per contiguous range of rows, starting
+ * with the last range so that the rows of the remaining ranges stay valid. The edges are
+ * only taken afterwards; until then, the graph node maps the rows of tree nodes that
+ * have already been updated, so that handlers of rowsRemoved see the remaining children.
+ * Finally, the destroyed items and the removed relations are announced.
+ *
+ * @param graph_parent the node whose children are removed
+ * @param rows distinct valid rows in ascending order
+ */
+void TreeItemModel::remove_graph_children(GraphNode* graph_parent, const std::vector<int>& rows) {
+    this->flush_changes();
+    std::vector<std::pair<int, int>> ranges; // First and last row, in descending order
+    for (auto row = rows.rbegin(); row != rows.rend(); ++row) {
+        if (!ranges.empty() && ranges.back().first == *row + 1) {
+            ranges.back().first = *row;
+        } else {
+            ranges.emplace_back(*row, *row);
+        }
+    }
+
+    graph_parent->begin_child_removal(rows);
+    QSet<const TreeNode*> updated_tree_nodes;
+    auto tree_nodes = TreeItemModel::prepare_tree_nodes(graph_parent);
+    while (!tree_nodes.empty()) {
+        for (auto* tree_node : tree_nodes) {
+            const auto parent_index = this->create_index(tree_node);
+            for (const auto& [first_row, last_row] : ranges) {
+                this->beginRemoveRows(parent_index, first_row, last_row);
+                tree_node->remove_children(first_row, last_row - first_row + 1);
+                this->endRemoveRows();
+            }
+            updated_tree_nodes.insert(tree_node);
+        }
+        // Views may have visited further clones of the parent while handling the signals:
+        tree_nodes = TreeItemModel::prepare_tree_nodes(graph_parent, updated_tree_nodes);
+    }
+
+    RemovedRelations removed_relations;
+    QList<QtdId> removed_children;
+    for (auto row = rows.rbegin(); row != rows.rend(); ++row) {
+        removed_children.prepend(graph_parent->get_child(*row)->get_uuid());
+        this->remove_graph_edge(graph_parent, *row, removed_relations);
+    }
+    for (auto* tree_node : graph_parent->get_tree_nodes()) {
+        tree_node->end_child_removal();
+    }
+    graph_parent->end_child_removal();
+
+    if (!removed_relations.destroyed_items.isEmpty()) {
+        emit this->items_destroyed(removed_relations.destroyed_items);
+    }
+    emit this->relations_removed(this->get_item_id(graph_parent), removed_children);
+    for (auto relations = removed_relations.children_by_parent.cbegin();
+         relations != removed_relations.children_by_parent.cend();
+         ++relations) {
+        emit this->relations_removed(relations.key(), relations.value());
+    }
 }
 
 TreeNode* TreeItemModel::get_raw_node_pointer(const QModelIndex& index) const {
     return index.isValid()
         ? static_cast<TreeNode*>(index.internalPointer())
-        : this->root.get();
-}
-
-void TreeItemModel::remove_recursively_from_node_map(TreeNode* item) {
-    tree_nodes_foreach(item, [this](TreeNode* node) {
-        this->uuid_node_map.remove(node->get_data(UuidRole).value<QtdId>(), node);
-        return false;
-    });
+        : this->root;
 }
 
 int TreeItemModel::rowCount(const QModelIndex &parent) const {
@@ -213,7 +421,7 @@ QModelIndex TreeItemModel::parent(const QModelIndex& index) const {
     }
 
     const auto* parent_node = this->get_raw_node_pointer(index)->get_parent();
-    if (parent_node == this->root.get()) {
+    if (parent_node == this->root) {
         return {};
     }
 
@@ -238,27 +446,148 @@ QVariant TreeItemModel::data(const QModelIndex& index, int role) const {
 }
 
 QVariant TreeItemModel::data(const QtdId& uuid, int role) const {
-    if (auto* node = this->uuid_node_map.value(uuid)) {
+    if (auto* node = this->graph_nodes.value(uuid)) {
         return node->get_data(role);
     }
     return {};
 }
 
+/**
+ * @brief Returns the graph node with the given id, the root if the id is invalid
+ *        and nullptr if the id is unknown. No tree nodes are created.
+ */
+const GraphNode* TreeItemModel::find_graph_node(const QtdId& uuid) const {
+    return this->get_graph_node(uuid);
+}
+
+/**
+ * @brief Returns the ids of all items, every item once regardless of its clones.
+ */
+QList<QtdId> TreeItemModel::get_item_ids() const {
+    return this->graph_nodes.keys();
+}
+
+/**
+ * @brief Returns the ids of the items on the path from the top level down to the index.
+ */
+QList<QtdId> TreeItemModel::get_path(const QModelIndex& index) const {
+    QList<QtdId> result;
+    for (const auto* node = this->get_raw_node_pointer(index); node != this->root; node = node->get_parent()) {
+        result.prepend(node->get_graph_node()->get_uuid());
+    }
+    return result;
+}
+
+/**
+ * @brief Returns the index of the tree node reached by following the given ids from the
+ *        top level down, or an invalid index if there is no such path.
+ *
+ * Only the tree nodes on the path are created.
+ */
+QModelIndex TreeItemModel::find_index(const QList<QtdId>& path) const {
+    QModelIndex result;
+    const auto* graph_node = this->root_graph_node;
+    for (const auto& uuid : path) {
+        int row = 0;
+        while (row < graph_node->get_child_count() && graph_node->get_child(row)->get_uuid() != uuid) {
+            row++;
+        }
+        if (row == graph_node->get_child_count()) {
+            return {};
+        }
+        result = this->index(row, 0, result);
+        graph_node = graph_node->get_child(row);
+    }
+    return result;
+}
+
 bool TreeItemModel::setData(const QModelIndex& index, const QVariant& value, int role) {
     if (!index.isValid()) {
         return false;
     }
 
-    this->get_raw_node_pointer(index)->set_data(value, role);
+    auto* graph_node = this->get_raw_node_pointer(index)->get_graph_node();
+    graph_node->set_data(value, role);
+    this->record_change(graph_node, role);
+    this->announce_changes();
+    return true;
+}
+
+/**
+ * @brief Enable or disable collecting data changes until control returns to the event loop.
+ *
+ * Changes collected so far are announced when coalescing is disabled.
+ */
+void TreeItemModel::set_change_coalescing(bool enabled) {
+    this->coalesce_changes = enabled;
+    if (!enabled) {
+        this->flush_changes();
+    }
+}
+
+void TreeItemModel::record_change(GraphNode* graph_node, int role) {
+    auto& roles = this->pending_changes[graph_node];
+    if (!roles.contains(role)) {
+        roles.append(role);
+    }
+}
+
+/**
+ * @brief Announce the recorded changes now, or once control returns to the event loop
+ *        if coalescing is enabled.
+ */
+void TreeItemModel::announce_changes() {
+    if (!this->coalesce_changes) {
+        this->flush_changes();
+    } else if (!this->flush_scheduled) {
+        this->flush_scheduled = true;
+        QMetaObject::invokeMethod(this, &TreeItemModel::flush_changes, Qt::QueuedConnection);
+    }
+}
+
+/**
+ * @brief Announce all recorded changes with one dataChanged signal per contiguous range
+ *        of changed rows, carrying the union of the changed roles of these rows.
+ */
+void TreeItemModel::flush_changes() {
+    this->flush_scheduled = false;
+    if (this->pending_changes.isEmpty()) {
+        return;
+    }
 
-    this->operate_on_clones(
-        index,
-        [this, role](TreeNode* node) -> void {
-            const auto node_index = this->create_index(node);
-            emit this->dataChanged(node_index, node_index, {role});
+    const auto changes = std::exchange(this->pending_changes, {});
+    QHash<const TreeNode*, std::vector<ChangedRow>> changed_rows;
+    for (auto change = changes.cbegin(); change != changes.cend(); ++change) {
+        for (const auto* tree_node : change.key()->get_tree_nodes()) {
+            changed_rows[tree_node->get_parent()].push_back({tree_node->get_row_in_parent(), change.value()});
         }
-    );
-    return true;
+    }
+
+    for (auto change = changes.cbegin(); change != changes.cend(); ++change) {
+        emit this->item_changed(change.key()->get_uuid(), change.value());
+    }
+    // Views may create further tree nodes while handling the signals, these show the new data:
+    for (auto rows = changed_rows.begin(); rows != changed_rows.end(); ++rows) {
+        std::ranges::sort(rows.value(), {}, &ChangedRow::row);
+        const auto parent_index = this->create_index(rows.key());
+        for (auto first = rows->cbegin(); first != rows->cend();) {
+            auto roles = first->roles;
+            auto last = first;
+            for (; std::next(last) != rows->cend() && std::next(last)->row == last->row + 1; ++last) {
+                for (const auto role : std::next(last)->roles) {
+                    if (!roles.contains(role)) {
+                        roles.append(role);
+                    }
+                }
+            }
+            emit this->dataChanged(
+                this->index(first->row, 0, parent_index),
+                this->index(last->row, 0, parent_index),
+                roles
+            );
+            first = std::next(last);
+        }
+    }
 }
 
 bool TreeItemModel::removeRows(int row, int count, const QModelIndex &parent) {
@@ -268,19 +597,46 @@ bool TreeItemModel::removeRows(int row, int count, const QModelIndex &parent) {
         return false;
     }
 
-    this->operate_on_clones(
-        parent,
-        [this, row, count](TreeNode* node) -> void {
-            for (int i=row; i<row+count; i++) {
-                this->remove_recursively_from_node_map(node->get_child(i));
-            }
-            auto node_index = this->create_index(node);
-            this->beginRemoveRows(node_index, row, row+count-1);
-            node->remove_children(row, count);
-            this->endRemoveRows();
+    std::vector<int> rows(count);
+    std::iota(rows.begin(), rows.end(), row);
+    this->remove_graph_children(parent_node->get_graph_node(), rows);
+    return true;
+}
+
+/**
+ * @brief Remove several items at once; they may have different parents and need not be adjacent.
+ *
+ * Indexes of clones that refer to the same relation are removed once. The rows of every
+ * parent are removed with one signal per contiguous range and tree node of the parent.
+ * Parents are processed in reverse topological order: removing the relations of a parent
+ * can only destroy its descendants, whose relations have been removed already.
+ *
+ * @param indexes the items to remove from their parents
+ * @return false without removing anything if one of the indexes is invalid
+ */
+bool TreeItemModel::remove_items(const QModelIndexList& indexes) {
+    QHash<GraphNode*, std::vector<int>> rows_by_parent;
+    for (const auto& index : indexes) {
+        if (!this->checkIndex(index, CheckIndexOption::IndexIsValid)) {
+            return false;
         }
-    );
+        const auto* parent_node = this->get_raw_node_pointer(index)->get_parent();
+        rows_by_parent[parent_node->get_graph_node()].push_back(index.row());
+    }
 
+    auto graph_parents = rows_by_parent.keys();
+    std::ranges::sort(
+        graph_parents,
+        [](const GraphNode* node, const GraphNode* other_node) {
+            return node->get_topological_rank() > other_node->get_topological_rank();
+        }
+    );
+    for (auto* graph_parent : graph_parents) {
+        auto& rows = rows_by_parent[graph_parent];
+        std::ranges::sort(rows);
+        rows.erase(std::ranges::unique(rows).begin(), rows.end());
+        this->remove_graph_children(graph_parent, rows);
+    }
     return true;
 }
 
@@ -288,8 +644,8 @@ bool TreeItemModel::removeRows(int row, int count, const QModelIndex &parent) {
  * @brief Creates a tree node as a child of all nodes associated with the given id
  *
  * If the id is invalid, the tree node will be added without a parent (top level),
- * if the id is valid but unknown, the node is not created and the function returns
- * false.
+ * if the id is valid but unknown or the id of the data item is already in use, the
+ * node is not created and the function returns false.
  *
  * @param data_item The data that is stored in the node
  * @param parent_uuid The id identifying the parents of the new node
@@ -299,10 +655,18 @@ bool TreeItemModel::create_tree_node(
     std::unique_ptr<UniqueDataItem> data_item,
     const QtdId& parent_uuid
 ) {
-    return this->add_tree_node(
-        TreeNode::create(std::move(data_item)),
-        parent_uuid
-    );
+    auto* parent = this->get_graph_node(parent_uuid);
+    const auto uuid = data_item->get_uuid();
+    if (parent == nullptr || this->graph_nodes.contains(uuid)) {
+        return false;
+    }
+
+    auto* graph_node = this->graph_node_pool.create(std::move(data_item));
+    graph_node->set_topological_rank(this->next_topological_rank++);
+    this->graph_nodes.insert(uuid, graph_node);
+    emit this->item_created(uuid);
+    this->add_graph_edge(parent, graph_node);
+    return true;
 }
 
 
@@ -310,6 +674,7 @@ bool TreeItemModel::create_tree_node(
  * @brief Clones an existing tree node such that the corresponding
  *        data item appears multiple times in the tree
  *
+ * The item and its children are not copied, the item merely gets another parent.
  * If cloning the tree node would create a dependency cycle, this function
  * does nothing and returns false.
  *
@@ -321,21 +686,137 @@ bool TreeItemModel::clone_tree_node(
     const QtdId& uuid,
     const QtdId& parent_uuid
 ){
-    if (!this->uuid_node_map.contains(uuid)) {
+    auto* graph_node = this->graph_nodes.value(uuid);
+    auto* parent = this->get_graph_node(parent_uuid);
+    if (graph_node == nullptr || parent == nullptr) {
         return false;
     }
 
-    auto node_clone = TreeNode::clone(this->uuid_node_map.value(uuid));
-    return this->add_tree_node(
-        std::move(node_clone),
-        parent_uuid
-    );
+    if (!TreeItemModel::update_topological_order(parent, graph_node)) {
+        return false;
+    }
+
+    this->add_graph_edge(parent, graph_node);
+    return true;
+}
+
+/**
+ * @brief Change several items at once and announce the changes together, with one
+ *        dataChanged signal per contiguous range of changed rows.
+ *
+ * @param uuids the ids of the items to change; an id may occur several times
+ * @param values the value to set for the item at the same position
+ * @param role the role to change
+ * @return false without changing anything if an id is unknown or the lists differ in length
+ */
+bool TreeItemModel::set_data_of_items(const QList<QVariant>& uuids, const QList<QVariant>& values, int role) {
+    if (uuids.size() != values.size()) {
+        return false;
+    }
+    std::vector<GraphNode*> changed_nodes;
+    changed_nodes.reserve(uuids.size());
+    for (const auto& uuid : uuids) {
+        auto* graph_node = this->graph_nodes.value(uuid.value<QtdId>());
+        if (graph_node == nullptr) {
+            return false;
+        }
+        changed_nodes.push_back(graph_node);
+    }
+
+    for (qsizetype i=0; i<uuids.size(); i++) {
+        changed_nodes[i]->set_data(values.at(i), role);
+        this->record_change(changed_nodes[i], role);
+    }
+    this->announce_changes();
+    return true;
+}
+
+/**
+ * @brief Replace the content of the model by the given items and their relations.
+ *
+ * Unlike adding nodes one by one, the graph is created in a single pass, the relations
+ * are checked for cycles only once and views are notified by one model reset. The items
+ * may be passed in any order; the children of a node keep the order of the relations,
+ * the top level items the order of the items. Relations referring to an unknown item
+ * are ignored.
+ *
+ * @param data_items the items to store, their ids must be distinct
+ * @param relations pairs of the id of an item and the id of one of its parents
+ * @return false if the relations contain a cycle, the model is empty in that case
+ */
+bool TreeItemModel::load_tree(
+    std::vector<std::unique_ptr<UniqueDataItem>> data_items,
+    const QList<QPair<QtdId, QtdId>>& relations
+) {
+    this->beginResetModel();
+    this->clear();
+    const bool success = this->build_graph(std::move(data_items), relations);
+    if (!success) {
+        this->clear();
+    }
+    this->endResetModel();
+    return success;
+}
+
+/**
+ * @brief Create a graph node for every item and connect it to its parents, or to the
+ *        root if it has none. Tree nodes are created later when the tree is visited.
+ */
+bool TreeItemModel::build_graph(
+    std::vector<std::unique_ptr<UniqueDataItem>> data_items,
+    const QList<QPair<QtdId, QtdId>>& relations
+) {
+    const auto item_count = data_items.size();
+    QHash<QtdId, std::size_t> positions;
+    positions.reserve(static_cast<qsizetype>(item_count));
+    for (std::size_t position=0; position<item_count; ++position) {
+        positions.insert(data_items[position]->get_uuid(), position);
+    }
+
+    std::vector<std::vector<std::size_t>> children(item_count);
+    std::vector<bool> is_top_level(item_count, true);
+    for (const auto& [child_uuid, parent_uuid] : relations) {
+        const auto child_position = positions.constFind(child_uuid);
+        const auto parent_position = positions.constFind(parent_uuid);
+        if (child_position != positions.cend() && parent_position != positions.cend()) {
+            children[*parent_position].push_back(*child_position);
+            is_top_level[*child_position] = false;
+        }
+    }
+
+    const auto topological_order = get_topological_order(children);
+    if (topological_order.size() != item_count) {
+        return false;
+    }
+
+    // The graph nodes are allocated only now to place them next to each other:
+    std::vector<GraphNode*> nodes;
+    nodes.reserve(item_count);
+    this->graph_nodes.reserve(static_cast<qsizetype>(item_count));
+    for (auto& data_item : data_items) {
+        const auto uuid = data_item->get_uuid();
+        nodes.push_back(this->graph_node_pool.create(std::move(data_item)));
+        this->graph_nodes.insert(uuid, nodes.back());
+    }
+    for (const auto position : topological_order) {
+        nodes[position]->set_topological_rank(this->next_topological_rank++);
+    }
+    for (std::size_t position=0; position<item_count; ++position) {
+        for (const auto child : children[position]) {
+            nodes[position]->add_child(nodes[child]);
+        }
+        if (is_top_level[position]) {
+            this->root_graph_node->add_child(nodes[position]);
+        }
+    }
+    return true;
 }
 
 /**
  * @brief Returns the number of nodes in the tree. Clones are counted separately.
  */
 qsizetype TreeItemModel::get_size() {
-    return this->uuid_node_map.size() - 1;
+    QHash<const GraphNode*, qsizetype> path_counts;
+    return count_paths(this->root_graph_node, path_counts) - 1;
     // Subtract one to not count root node
 }
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -18,54 +18,114 @@
 
 #pragma once
 
-#include <functional>
 #include <memory>
+#include <vector>
 
 #include <QAbstractItemModel>
-#include <QMultiHash>
+#include <QHash>
+#include <QList>
+#include <QModelIndexList>
+#include <QPair>
+#include <QSet>
+#include <QVariant>
 #include <QtTypes>
 
+#include "dataitems/graphnode.h"
 #include "dataitems/qtdid.h"
 #include "dataitems/treenode.h"
 #include "dataitems/uniquedataitem.h"
+#include "utils/objectpool.h"
 
 
 /**
  * @brief A Qt model class representing a dependency graph.
  *
- * Qt's model-view-framework requires exactly one parent per node. This class maps
- * a graph of dependencies to the parent-child relation of Qt by cloning nodes (same
- * stored data but different position in the tree).
- * Any modifying operation on a tree node is also performed on all of its clones.
+ * Qt's model-view-framework requires exactly one parent per node. This class stores
+ * the dependencies as a graph, in which every item and its children exist only once,
+ * and presents every path through the graph as a separate node of the tree (a clone).
+ * The tree nodes are lightweight handles that are only created for visited branches.
+ * Observers that need every item, like the TaskSearchIndex, the TaskColumnStore and the
+ * FilteredTaskItemModel, do not walk the tree: they read the graph and follow the changes
+ * of the items and their relations via the signals of this class, so that only views
+ * create tree nodes.
+ * Graph and tree nodes are allocated from pools owned by the model.
+ * Any modifying operation on an item is announced for all of its existing tree nodes,
+ * with one dataChanged signal per contiguous range of changed rows.
+ * If coalescing is enabled, data changes are collected until control returns to the
+ * event loop or the structure of the tree changes, and are announced together.
+ * The graph nodes are kept in topological order, so that most new dependencies can be
+ * checked for cycles without traversing the graph.
  */
 class TreeItemModel : public QAbstractItemModel {
 
+    Q_OBJECT
+
 private:
 
+    /**
+     * @brief All graph and tree nodes are allocated from these pools; declared first
+     *        to be destroyed last.
+     */
+    ObjectPool<GraphNode> graph_node_pool;
+    ObjectPool<TreeNode> tree_node_pool;
+
     /**
      * @brief Auxiliary dependent of every item that is not a dependency of another one
      */
-    std::unique_ptr<TreeNode> root;
+    GraphNode* root_graph_node = nullptr;
 
     /**
-     * @brief Maps an ID to a list of corresponding TreeNodes.
+     * @brief Maps an ID to the graph node storing the item.
      */
-    QMultiHash<QtdId, TreeNode*> uuid_node_map;
+    QHash<QtdId, GraphNode*> graph_nodes;
+
+    /**
+     * @brief The tree node of the root; all other tree nodes are its descendants.
+     */
+    TreeNode* root = nullptr;
+
+    /**
+     * @brief The topological rank of the next created graph node; larger than all existing ones
+     */
+    qsizetype next_topological_rank = 1;
+
+    /**
+     * @brief The roles of every graph node that changed since the last announcement
+     */
+    QHash<GraphNode*, QList<int>> pending_changes;
+
+    bool coalesce_changes = false;
+    bool flush_scheduled = false;
+
+    /**
+     * @brief Changes of the graph collected while relations are removed, see remove_graph_edge
+     */
+    struct RemovedRelations {
+        QList<QtdId> destroyed_items;
+        QHash<QtdId, QList<QtdId>> children_by_parent;
+    };
 
     [[nodiscard]] TreeNode* get_raw_node_pointer(const QModelIndex& index) const;
-    void remove_recursively_from_node_map(TreeNode* item);
+    [[nodiscard]] GraphNode* get_graph_node(const QtdId& uuid) const;
+    [[nodiscard]] QtdId get_item_id(const GraphNode* graph_node) const;
     QModelIndex create_index(const TreeNode* node) const;
 
-    void operate_on_clones(
-        const QtdId& uuid,
-        const std::function<void(TreeNode*)>& operation
+    [[nodiscard]] static std::vector<TreeNode*> prepare_tree_nodes(
+        const GraphNode* graph_node,
+        const QSet<const TreeNode*>& excluded_tree_nodes = {}
     );
-    void operate_on_clones(
-        const QModelIndex& node_index,
-        const std::function<void(TreeNode*)>& operation
+    [[nodiscard]] static bool update_topological_order(GraphNode* parent, GraphNode* child);
+    void add_graph_edge(GraphNode* parent, GraphNode* child);
+    void remove_graph_edge(GraphNode* parent, int row, RemovedRelations& removed_relations);
+    void remove_graph_children(GraphNode* graph_parent, const std::vector<int>& rows);
+    bool build_graph(
+        std::vector<std::unique_ptr<UniqueDataItem>> data_items,
+        const QList<QPair<QtdId, QtdId>>& relations
     );
-    bool add_tree_node(std::unique_ptr<TreeNode> new_node, const QtdId& parent_uuid);
-    void add_recursively_to_uuid_node_map(TreeNode* node);
+    void clear();
+    void release_nodes();
+    void record_change(GraphNode* graph_node, int role);
+    void announce_changes();
 
 protected:
     bool create_tree_node(
@@ -76,11 +136,21 @@ protected:
         const QtdId& uuid,
         const QtdId& parent_uuid = QtdId()
     );
+    bool load_tree(
+        std::vector<std::unique_ptr<UniqueDataItem>> data_items,
+        const QList<QPair<QtdId, QtdId>>& relations
+    );
+    bool set_data_of_items(const QList<QVariant>& uuids, const QList<QVariant>& values, int role);
 
 
 public:
 
     explicit TreeItemModel(QObject *parent = nullptr);
+    TreeItemModel(const TreeItemModel&)            = delete;
+    TreeItemModel(TreeItemModel&&)                 = delete;
+    TreeItemModel& operator=(const TreeItemModel&) = delete;
+    TreeItemModel& operator=(TreeItemModel&&)      = delete;
+    ~TreeItemModel() override;
 
     // Required for read-only access:
     [[nodiscard]] int rowCount(const QModelIndex& parent = QModelIndex()) const override;
@@ -98,8 +168,26 @@ public:
     bool removeRows(
         int row, int count, const QModelIndex& parent = QModelIndex()
     ) override;
+    virtual bool remove_items(const QModelIndexList& indexes);
+
+    // Change notifications:
+    void set_change_coalescing(bool enabled);
+    void flush_changes();
 
     // Convenience functions:
     qsizetype get_size();
     [[nodiscard]] QVariant data(const QtdId& uuid, int role) const;
+
+    // Access to the items without creating tree nodes:
+    [[nodiscard]] const GraphNode* find_graph_node(const QtdId& uuid) const;
+    [[nodiscard]] QList<QtdId> get_item_ids() const;
+    [[nodiscard]] QList<QtdId> get_path(const QModelIndex& index) const;
+    [[nodiscard]] QModelIndex find_index(const QList<QtdId>& path) const;
+
+signals:
+    void item_created(const QtdId& uuid);
+    void items_destroyed(const QList<QtdId>& uuids);
+    void item_changed(const QtdId& uuid, const QList<int>& roles);
+    void relation_added(const QtdId& parent_uuid, const QtdId& child_uuid);
+    void relations_removed(const QtdId& parent_uuid, const QList<QtdId>& child_uuids);
 };
@@ -0,0 +1,72 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "databaseworker.h"
+
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
+#include "statementcache.h"
+
+DatabaseWorker::DatabaseWorker(const QString& source_connection_name, QObject* parent)
+    : QObject{parent}, connection_name(source_connection_name + "_worker")
+{
+    const auto source_database = QSqlDatabase::database(source_connection_name, false);
+    this->driver_name     = source_database.driverName();
+    this->database_name   = source_database.databaseName();
+    this->connect_options = source_database.connectOptions();
+
+    QSqlQuery query(source_database);
+    this->foreign_keys_enabled
+        = query.exec("PRAGMA foreign_keys;") && query.next() && query.value(0).toBool();
+
+    // A single thread that never expires, so that the connection is always used by the thread owning it:
+    this->thread_pool.setMaxThreadCount(1);
+    this->thread_pool.setExpiryTimeout(-1);
+}
+
+DatabaseWorker::~DatabaseWorker() {
+    QtConcurrent::run(
+        &this->thread_pool,
+        [connection_name = this->connection_name]() {
+            StatementCache::close_connection(connection_name);
+        }
+    ).waitForFinished();
+    this->thread_pool.waitForDone();
+    QSqlDatabase::removeDatabase(this->connection_name);
+}
+
+void DatabaseWorker::open_connection_if_required() const {
+    if (QSqlDatabase::contains(this->connection_name)) {
+        return;
+    }
+    auto database = QSqlDatabase::addDatabase(this->driver_name, this->connection_name);
+    database.setDatabaseName(this->database_name);
+    database.setConnectOptions(this->connect_options);
+    database.open();
+    if (this->foreign_keys_enabled) {
+        QSqlQuery(database).exec("PRAGMA foreign_keys = ON;");
+    }
+}
+
+const QString& DatabaseWorker::get_connection_name() const {
+    return this->connection_name;
+}
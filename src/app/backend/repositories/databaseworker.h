@@ -0,0 +1,83 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <utility>
+
+#include <QFuture>
+#include <QObject>
+#include <QString>
+#include <QThreadPool>
+#include <QtConcurrentRun>
+
+/**
+ * @brief Executes database operations on a dedicated thread with its own connection.
+ *
+ * The worker opens a second connection to the database of the given source connection
+ * in its thread; the source connection has to refer to a database file, as in-memory
+ * databases can not be shared between connections. Operations are executed one after
+ * another in the order they were submitted.
+ *
+ * The worker's connection is meant to be the only one that writes: the application
+ * sends all changes through a PersistenceQueue using the worker and only reads on the
+ * source connection. Writes on both connections would neither be ordered nor wait for
+ * each other except via SQLite's busy timeout.
+ */
+class DatabaseWorker : public QObject
+{
+    Q_OBJECT
+
+private:
+    QString connection_name;
+    QString driver_name;
+    QString database_name;
+    QString connect_options;
+    bool foreign_keys_enabled;
+    QThreadPool thread_pool;
+
+    void open_connection_if_required() const;
+
+public:
+    explicit DatabaseWorker(const QString& source_connection_name, QObject* parent = nullptr);
+    DatabaseWorker(const DatabaseWorker&)            = delete;
+    DatabaseWorker(DatabaseWorker&&)                 = delete;
+    DatabaseWorker& operator=(const DatabaseWorker&) = delete;
+    DatabaseWorker& operator=(DatabaseWorker&&)      = delete;
+    ~DatabaseWorker() override;
+
+    [[nodiscard]] const QString& get_connection_name() const;
+
+    /**
+     * @brief Execute an operation on the worker thread.
+     *
+     * The operation receives the name of the worker's connection; it must not be
+     * used outside of the operation.
+     */
+    template <typename T>
+    QFuture<T> run(std::function<T(const QString&)> operation) {
+        return QtConcurrent::run(
+            &this->thread_pool,
+            [this, operation = std::move(operation)]() {
+                this->open_connection_if_required();
+                return operation(this->connection_name);
+            }
+        );
+    }
+};
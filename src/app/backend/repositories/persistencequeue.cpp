@@ -0,0 +1,235 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "persistencequeue.h"
+
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include <QFuture>
+#include <QObject>
+#include <QSignalBlocker>
+#include <QString>
+#include <QTimer>
+
+#include "databaseworker.h"
+#include "transactionalrepository.h"
+
+namespace {
+
+/**
+ * @brief Holds the transaction joined by all repositories created while the queue is flushed.
+ */
+class QueueTransaction final : public TransactionalRepository {
+public:
+    explicit QueueTransaction(const QString& connection_name)
+        : TransactionalRepository(connection_name) {}
+};
+
+} // anonymous namespace
+
+PersistenceQueue::PersistenceQueue(QString connection_name, QObject* parent)
+    : QObject{parent}, connection_name(std::move(connection_name))
+{
+    this->flush_timer.setSingleShot(true);
+    this->flush_timer.setInterval(PersistenceQueue::default_flush_delay_ms);
+    connect(&this->flush_timer, &QTimer::timeout, this, &PersistenceQueue::flush_async);
+}
+
+PersistenceQueue::~PersistenceQueue() {
+    const QSignalBlocker blocker(this);
+    this->flush();
+}
+
+void PersistenceQueue::enqueue(Operation operation, const QString& coalescing_key) {
+    if (!coalescing_key.isEmpty()) {
+        const auto position = this->pending_positions.constFind(coalescing_key);
+        if (position != this->pending_positions.cend()) {
+            this->pending_operations[*position].operation = std::move(operation);
+            return;
+        }
+        this->pending_positions.insert(
+            coalescing_key,
+            static_cast<qsizetype>(this->pending_operations.size())
+        );
+    }
+    this->pending_operations.push_back({coalescing_key, std::move(operation)});
+    if (!this->flush_timer.isActive()) {
+        this->flush_timer.start();
+    }
+}
+
+void PersistenceQueue::set_flush_delay(int milliseconds) {
+    this->flush_timer.setInterval(milliseconds);
+}
+
+qsizetype PersistenceQueue::get_pending_count() const {
+    return static_cast<qsizetype>(this->pending_operations.size());
+}
+
+const QString& PersistenceQueue::get_connection_name() const {
+    return this->connection_name;
+}
+
+void PersistenceQueue::set_database_worker(DatabaseWorker* database_worker) {
+    this->flush();
+    this->database_worker = database_worker;
+}
+
+std::vector<PersistenceQueue::PendingOperation> PersistenceQueue::take_pending_operations() {
+    this->flush_timer.stop();
+    this->pending_positions.clear();
+    return std::exchange(this->pending_operations, {});
+}
+
+bool PersistenceQueue::execute_in_transaction(
+    std::span<const PendingOperation> operations,
+    const QString& connection_name
+) {
+    bool success = true;
+    try {
+        QueueTransaction transaction(connection_name);
+        for (const auto& pending : operations) {
+            if (!pending.operation(connection_name)) {
+                success = false;
+                break;
+            }
+        }
+        transaction.roll_back_on_failure(success);
+    } catch (const std::runtime_error&) {
+        success = false;
+    }
+    return success;
+}
+
+/**
+ * @brief Write a batch in a single transaction.
+ *
+ * If the batch fails, it is rolled back and every operation is written again in its own
+ * transaction, so that only the failing operations (and those depending on them) are lost.
+ *
+ * @return false if any operation failed
+ */
+bool PersistenceQueue::execute(
+    const std::vector<PendingOperation>& operations,
+    const QString& connection_name
+) {
+    if (PersistenceQueue::execute_in_transaction(operations, connection_name)) {
+        return true;
+    }
+    for (const auto& pending : operations) {
+        PersistenceQueue::execute_in_transaction({&pending, 1}, connection_name);
+    }
+    return false;
+}
+
+/**
+ * @brief Wait for a flush running on the database worker.
+ * @return false if that flush failed; its continuation reports the failure.
+ */
+bool PersistenceQueue::wait_for_running_flush() {
+    if (!this->running_flush.isValid()) {
+        return true;
+    }
+    const bool success = this->running_flush.result();
+    this->running_flush = QFuture<bool>();
+    return success;
+}
+
+bool PersistenceQueue::is_idle() const {
+    return this->pending_operations.empty()
+           && (!this->running_flush.isValid() || this->running_flush.isFinished());
+}
+
+/**
+ * @brief Emit flush_failed for the failures recorded so far once all operations are written.
+ *
+ * Operations queued meanwhile are written right away, so that the models do not reload
+ * data that is still about to change.
+ */
+void PersistenceQueue::report_failure_when_idle() {
+    if (!this->failure_unreported) {
+        return;
+    }
+    if (!this->pending_operations.empty()) {
+        this->flush_async();
+        return;
+    }
+    if (!this->is_idle()) {
+        return; // Reported by the continuation of the running flush
+    }
+    this->failure_unreported = false;
+    emit this->flush_failed();
+}
+
+/**
+ * @brief Execute all pending operations in a single transaction and wait for the result.
+ *
+ * This blocks the calling thread until a flush running on the database worker and the
+ * pending operations have been written; it is meant for shutdown and reconfiguration.
+ * Regular flushes are started by the timer and use flush_async.
+ *
+ * @return false if any operation failed
+ */
+bool PersistenceQueue::flush() {
+    const bool running_flush_succeeded = this->wait_for_running_flush();
+    if (this->pending_operations.empty()) {
+        return running_flush_succeeded;
+    }
+
+    auto operations = this->take_pending_operations();
+    const bool success = (this->database_worker == nullptr)
+        ? PersistenceQueue::execute(operations, this->connection_name)
+        : this->database_worker->run<bool>(
+              [operations = std::move(operations)](const QString& connection_name) {
+                  return PersistenceQueue::execute(operations, connection_name);
+              }
+          ).result();
+
+    this->failure_unreported |= !success;
+    this->report_failure_when_idle();
+    return success && running_flush_succeeded;
+}
+
+/**
+ * @brief Execute all pending operations on the database worker without waiting for the result.
+ *
+ * Without a database worker, this is equivalent to flush.
+ */
+void PersistenceQueue::flush_async() {
+    if (this->database_worker == nullptr) {
+        this->flush();
+        return;
+    }
+    if (this->pending_operations.empty()) {
+        return;
+    }
+
+    // The worker executes operations in order; waiting for the latest flush covers all earlier ones.
+    this->running_flush = this->database_worker->run<bool>(
+        [operations = this->take_pending_operations()](const QString& connection_name) {
+            return PersistenceQueue::execute(operations, connection_name);
+        }
+    );
+    this->running_flush.then(this, [this](bool success) {
+        this->failure_unreported |= !success;
+        this->report_failure_when_idle();
+    });
+}
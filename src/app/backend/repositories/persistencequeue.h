@@ -0,0 +1,148 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <functional>
+#include <span>
+#include <vector>
+
+#include <QFuture>
+#include <QHash>
+#include <QObject>
+#include <QPointer>
+#include <QString>
+#include <QTimer>
+#include <QtTypes>
+
+#include "databaseworker.h"
+
+/**
+ * @brief Collects repository operations and writes them to the database in a single transaction.
+ *
+ * Models in write-behind mode apply their changes in memory immediately and enqueue the
+ * corresponding repository operations. The queue is flushed after a short delay (a delay of
+ * zero flushes as soon as the event loop is idle), on request or on destruction. Operations
+ * sharing a coalescing key replace each other, e.g. consecutive updates of the same column.
+ *
+ * If an operation fails, the batch is rolled back and its operations are written one by one,
+ * so that only the failing operations are lost. flush_failed is emitted afterwards; the
+ * models are expected to reload their data from the database in that case, which reverts
+ * exactly the changes that could not be written. The failure is only reported once all
+ * operations queued so far have been written, so that the reload reads the final state.
+ *
+ * If a DatabaseWorker is set, the batches are written on its thread; flushes triggered by
+ * the timer then do not block the calling thread. All writes of the application have to
+ * go through the queue, so that they are executed on a single connection in the order
+ * they were made.
+ */
+class PersistenceQueue : public QObject
+{
+    Q_OBJECT
+
+public:
+    /**
+     * @brief A repository operation on the given connection; returns false on failure.
+     */
+    using Operation = std::function<bool(const QString& connection_name)>;
+
+    /**
+     * @brief Apply a change to a model and persist it with the given repository operation.
+     *
+     * With a queue, the model is changed first and the operation is queued if that
+     * succeeded; the operation runs later, possibly on the database worker, and must
+     * therefore only capture values. Without a queue, the operation is executed in its
+     * own transaction, which is rolled back if changing the model fails.
+     *
+     * @return false if the model or, without a queue, the database could not be changed
+     */
+    template <typename Repository>
+    static bool apply_and_persist(
+        PersistenceQueue* queue,
+        const QString& connection_name,
+        const std::function<bool(const Repository&)>& operation,
+        const std::function<bool()>& change_model,
+        const QString& coalescing_key = ""
+    ) {
+        if (queue != nullptr) {
+            if (!change_model()) {
+                return false;
+            }
+            queue->enqueue(
+                [operation](const QString& queue_connection_name) {
+                    auto repository = Repository::create(queue_connection_name);
+                    return repository.roll_back_on_failure(operation(repository));
+                },
+                coalescing_key
+            );
+            return true;
+        }
+        auto repository = Repository::create(connection_name);
+        return repository.roll_back_on_failure(operation(repository) && change_model());
+    }
+
+    static constexpr int default_flush_delay_ms = 250;
+
+private:
+    struct PendingOperation {
+        QString coalescing_key;
+        Operation operation;
+    };
+
+    QString connection_name;
+    std::vector<PendingOperation> pending_operations;
+    QHash<QString, qsizetype> pending_positions;
+    QTimer flush_timer;
+    QPointer<DatabaseWorker> database_worker;
+    QFuture<bool> running_flush;
+    bool failure_unreported = false;
+
+    [[nodiscard]] std::vector<PendingOperation> take_pending_operations();
+    [[nodiscard]] static bool execute_in_transaction(
+        std::span<const PendingOperation> operations,
+        const QString& connection_name
+    );
+    [[nodiscard]] static bool execute(
+        const std::vector<PendingOperation>& operations,
+        const QString& connection_name
+    );
+    bool wait_for_running_flush();
+    void report_failure_when_idle();
+
+public:
+    explicit PersistenceQueue(QString connection_name, QObject* parent = nullptr);
+    PersistenceQueue(const PersistenceQueue&)            = delete;
+    PersistenceQueue(PersistenceQueue&&)                 = delete;
+    PersistenceQueue& operator=(const PersistenceQueue&) = delete;
+    PersistenceQueue& operator=(PersistenceQueue&&)      = delete;
+    ~PersistenceQueue() override;
+
+    void enqueue(Operation operation, const QString& coalescing_key = "");
+    void set_flush_delay(int milliseconds);
+    void set_database_worker(DatabaseWorker* database_worker);
+    [[nodiscard]] qsizetype get_pending_count() const;
+    [[nodiscard]] bool is_idle() const;
+    [[nodiscard]] const QString& get_connection_name() const;
+
+public slots:
+    bool flush();
+    void flush_async();
+
+signals:
+    void flush_failed();
+};
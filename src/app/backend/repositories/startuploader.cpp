@@ -0,0 +1,205 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "startuploader.h"
+
+#include <memory>
+#include <numeric>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QFuture>
+#include <QHash>
+#include <QList>
+#include <QLoggingCategory>
+#include <QPair>
+#include <QSet>
+#include <QSqlDatabase>
+#include <QString>
+#include <QThreadPool>
+#include <QVariantList>
+#include <QtConcurrentMap>
+#include <QtConcurrentRun>
+
+#include "dataitems/qtdid.h"
+#include "dataitems/tag.h"
+#include "dataitems/task.h"
+#include "statementcache.h"
+#include "tagrepository.h"
+#include "taskrepository.h"
+
+Q_LOGGING_CATEGORY(startup_log, "qtd.startup")
+
+namespace {
+
+constexpr int number_of_result_sets = 4;
+
+QList<QVariantList> read_task_rows(const QString& connection_name) {
+    const auto task_repository = TaskRepository::create(connection_name);
+    QList<QVariantList> result;
+    for (auto& row : task_repository.get_all_task_rows()) {
+        result.append(std::move(row));
+    }
+    return result;
+}
+
+QList<QPair<TaskId, TaskId>> read_dependencies(const QString& connection_name) {
+    return TaskRepository::create(connection_name).get_all_dependencies();
+}
+
+QHash<TaskId, QSet<TagId>> read_tag_assignments(const QString& connection_name) {
+    return TaskRepository::create(connection_name).get_all_tag_assignments();
+}
+
+QList<QVariantList> read_tag_rows(const QString& connection_name) {
+    const auto tag_repository = TagRepository::create(connection_name);
+    QList<QVariantList> result;
+    for (auto& row : tag_repository.get_all_tag_rows()) {
+        result.append(std::move(row));
+    }
+    return result;
+}
+
+bool supports_reader_connections(const QString& connection_name) {
+    const auto database_name = QSqlDatabase::database(connection_name, false).databaseName();
+    return !database_name.isEmpty() && database_name != ":memory:";
+}
+
+/**
+ * @brief Run a read function on a temporary clone of the connection in the thread pool.
+ *
+ * Without a reader connection name, the function is executed immediately on the given connection.
+ */
+template <typename Read>
+QFuture<std::invoke_result_t<Read, const QString&>> fetch(
+    QThreadPool& thread_pool,
+    const QString& connection_name,
+    const QString& reader_connection_name,
+    Read read
+) {
+    using Result = std::invoke_result_t<Read, const QString&>;
+    if (reader_connection_name.isEmpty()) {
+        return QtFuture::makeReadyValueFuture(read(connection_name));
+    }
+    return QtConcurrent::run(
+        &thread_pool,
+        [connection_name, reader_connection_name, read]() {
+            Result result;
+            {
+                auto database = QSqlDatabase::cloneDatabase(connection_name, reader_connection_name);
+                database.open();
+                result = read(reader_connection_name);
+                StatementCache::close_connection(reader_connection_name);
+            }
+            QSqlDatabase::removeDatabase(reader_connection_name);
+            return result;
+        }
+    );
+}
+
+std::vector<std::unique_ptr<Task>> decode_tasks(
+    const QList<QVariantList>& rows,
+    const QHash<TaskId, QSet<TagId>>& tag_assignments
+) {
+    std::vector<std::unique_ptr<Task>> tasks(rows.size());
+    std::vector<qsizetype> positions(rows.size());
+    std::iota(positions.begin(), positions.end(), 0);
+
+    QtConcurrent::blockingMap(positions, [&](qsizetype position) {
+        auto task = std::make_unique<Task>(rows.at(position));
+        task->set_tags(tag_assignments.value(task->get_uuid()));
+        // Parses the description HTML, which is by far the most expensive part of decoding:
+        static_cast<void>(task->get_search_text());
+        tasks[position] = std::move(task);
+    });
+    return tasks;
+}
+
+std::vector<StartupLoader::LoadedTag> decode_tags(const QList<QVariantList>& rows) {
+    std::vector<StartupLoader::LoadedTag> tags(rows.size());
+    std::vector<qsizetype> positions(rows.size());
+    std::iota(positions.begin(), positions.end(), 0);
+
+    QtConcurrent::blockingMap(positions, [&](qsizetype position) {
+        const auto& row = rows.at(position);
+        tags[position] = {
+            std::make_unique<Tag>(row),
+            row.at(TagRepository::columns::parent_uuid).value<TagId>()
+        };
+    });
+    return tags;
+}
+
+} // anonymous namespace
+
+namespace StartupLoader {
+
+Snapshot load(const QString& connection_name) {
+    QElapsedTimer timer;
+    timer.start();
+
+    QThreadPool reader_pool;
+    reader_pool.setMaxThreadCount(number_of_result_sets);
+    const bool use_reader_connections = supports_reader_connections(connection_name);
+    const auto get_reader_connection_name = [&](int reader_index) {
+        return use_reader_connections ? QString("%1_reader_%2").arg(connection_name).arg(reader_index) : QString();
+    };
+
+    auto task_rows       = fetch(reader_pool, connection_name, get_reader_connection_name(0), read_task_rows);
+    auto dependencies    = fetch(reader_pool, connection_name, get_reader_connection_name(1), read_dependencies);
+    auto tag_assignments = fetch(reader_pool, connection_name, get_reader_connection_name(2), read_tag_assignments);
+    auto tag_rows        = fetch(reader_pool, connection_name, get_reader_connection_name(3), read_tag_rows);
+
+    Snapshot snapshot;
+    const auto fetched_task_rows       = task_rows.takeResult();
+    const auto fetched_tag_assignments = tag_assignments.takeResult();
+    const auto fetched_tag_rows        = tag_rows.takeResult();
+    snapshot.task_data.dependencies    = dependencies.takeResult();
+    snapshot.fetch_duration_ms = timer.restart();
+
+    snapshot.task_data.tasks = decode_tasks(fetched_task_rows, fetched_tag_assignments);
+    snapshot.tags = decode_tags(fetched_tag_rows);
+    snapshot.decode_duration_ms = timer.elapsed();
+
+    return snapshot;
+}
+
+TaskData load_tasks(const QString& connection_name) {
+    return {
+        decode_tasks(
+            read_task_rows(connection_name),
+            read_tag_assignments(connection_name)
+        ),
+        read_dependencies(connection_name)
+    };
+}
+
+std::vector<LoadedTag> load_tags(const QString& connection_name) {
+    return decode_tags(read_tag_rows(connection_name));
+}
+
+void log_durations(const Snapshot& snapshot, qint64 assembly_duration_ms) {
+    qCInfo(startup_log).nospace()
+        << "Startup: fetching " << snapshot.fetch_duration_ms
+        << " ms, decoding " << snapshot.decode_duration_ms
+        << " ms, assembly " << assembly_duration_ms << " ms";
+}
+
+} // namespace StartupLoader
@@ -0,0 +1,82 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <QList>
+#include <QLoggingCategory>
+#include <QPair>
+#include <QString>
+#include <QtTypes>
+
+#include "dataitems/qtdid.h"
+#include "dataitems/tag.h"
+#include "dataitems/task.h"
+
+Q_DECLARE_LOGGING_CATEGORY(startup_log)
+
+/**
+ * @brief Reads and decodes the content of a database before the models are built from it.
+ *
+ * Decoding, including the conversion of the task descriptions into search text, runs on
+ * the global thread pool. Only the assembly of the trees is left to the models, which
+ * happens in the thread owning them.
+ */
+namespace StartupLoader {
+
+struct TaskData {
+    std::vector<std::unique_ptr<Task>> tasks;
+    QList<QPair<TaskId, TaskId>> dependencies; // Prerequisites and their dependents, in creation order
+};
+
+struct LoadedTag {
+    std::unique_ptr<Tag> tag;
+    TagId parent_uuid;
+};
+
+struct Snapshot {
+    TaskData task_data;
+    std::vector<LoadedTag> tags;
+    qint64 fetch_duration_ms  = 0;
+    qint64 decode_duration_ms = 0;
+};
+
+/**
+ * @brief Load tasks and tags for the initial setup of the models.
+ *
+ * The four result sets of a database file are fetched concurrently, each on a temporary
+ * connection of its own. In-memory databases can only be read through the given
+ * connection and are fetched one after another.
+ */
+[[nodiscard]] Snapshot load(const QString& connection_name);
+
+/**
+ * @brief Load the tasks through the given connection only, e.g. to reload a model.
+ */
+[[nodiscard]] TaskData load_tasks(const QString& connection_name);
+[[nodiscard]] std::vector<LoadedTag> load_tags(const QString& connection_name);
+
+/**
+ * @brief Report the duration of every startup phase; the snapshot may already be moved from.
+ */
+void log_durations(const Snapshot& snapshot, qint64 assembly_duration_ms);
+
+} // namespace StartupLoader
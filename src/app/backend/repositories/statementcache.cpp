@@ -0,0 +1,92 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "statementcache.h"
+
+#include <memory>
+
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QSqlDatabase>
+#include <QSqlQuery>
+#include <QString>
+
+#include "utils/query_utilities.h"
+
+namespace {
+
+struct ConnectionCache {
+    QHash<QString, std::shared_ptr<QSqlQuery>> queries;
+    StatementCache::Statistics statistics;
+};
+
+QMutex cache_mutex;
+QHash<QString, ConnectionCache> connection_caches; // NOLINT (cppcoreguidelines-avoid-non-const-global-variables)
+
+} // anonymous namespace
+
+namespace StatementCache {
+
+std::shared_ptr<QSqlQuery> get_query(
+    const QString& connection_name,
+    const QString& sql_file_name,
+    const QString& replace_pattern,
+    const QString& replace_string
+) {
+    const QMutexLocker locker(&cache_mutex);
+    auto& connection_cache = connection_caches[connection_name];
+    const auto key = sql_file_name + '\n' + replace_pattern + '\n' + replace_string;
+
+    auto& query = connection_cache.queries[key];
+    if (query != nullptr) {
+        connection_cache.statistics.hits++;
+        return query;
+    }
+
+    connection_cache.statistics.misses++;
+    auto query_string = QueryUtilities::get_sql_query_string(sql_file_name);
+    if (!replace_pattern.isEmpty()) {
+        query_string.replace(replace_pattern, replace_string);
+    }
+    query = std::make_shared<QSqlQuery>(QSqlDatabase::database(connection_name));
+    if (!query->prepare(query_string)) {
+        connection_cache.queries.remove(key);
+        return nullptr;
+    }
+    return query;
+}
+
+Statistics get_statistics(const QString& connection_name) {
+    const QMutexLocker locker(&cache_mutex);
+    return connection_caches.value(connection_name).statistics;
+}
+
+void remove_connection(const QString& connection_name) {
+    const QMutexLocker locker(&cache_mutex);
+    connection_caches.remove(connection_name);
+}
+
+void close_connection(const QString& connection_name) {
+    remove_connection(connection_name);
+    if (QSqlDatabase::contains(connection_name)) {
+        QSqlDatabase::database(connection_name, false).close();
+    }
+}
+
+} // namespace StatementCache
@@ -0,0 +1,66 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <QSqlQuery>
+#include <QString>
+#include <QtTypes>
+
+/**
+ * @brief Prepared statements for the SQL resource files, kept alive per database connection.
+ *
+ * Every combination of SQL file and placeholder replacement is prepared once per connection
+ * and reused afterwards. Statements must only be used in the thread owning their connection.
+ *
+ * Cached statements keep their connection in use and become invalid when it is closed.
+ * Connections using the cache therefore have to be closed with close_connection, which
+ * releases the statements first; statements must not be kept beyond a single use.
+ */
+namespace StatementCache {
+
+struct Statistics {
+    qsizetype hits   = 0;
+    qsizetype misses = 0;
+};
+
+/**
+ * @brief Get the prepared statement of an SQL file, preparing it on first use.
+ * @return nullptr if the statement could not be prepared
+ */
+std::shared_ptr<QSqlQuery> get_query(
+    const QString& connection_name,
+    const QString& sql_file_name,
+    const QString& replace_pattern = "",
+    const QString& replace_string = ""
+);
+Statistics get_statistics(const QString& connection_name);
+
+/**
+ * @brief Release all statements of a connection; required before closing or removing it.
+ */
+void remove_connection(const QString& connection_name);
+
+/**
+ * @brief Release all statements of a connection and close it.
+ */
+void close_connection(const QString& connection_name);
+
+} // namespace StatementCache
@@ -37,12 +37,6 @@
  * of the used SqlResultIterator.
  */
 
-QVariant TagRepository::convert_id(const TagId &tag_id) {
-    return tag_id.is_valid()
-               ? QVariant(tag_id.toString())
-               : QVariant(QMetaType::fromType<TagId>());
-}
-
 TagRepository TagRepository::create(const QString &database_connection_name) {
     return TagRepository(database_connection_name); // NOLINT (modernize-return-braced-init-list)
 }
@@ -55,10 +49,21 @@ SqlResultView<Tag> TagRepository::get_all_tags() const {
     return SqlResultView<Tag>(std::move(query));
 }
 
+/**
+ * @brief The rows of get_all_tags() without constructing tags; see TagRepository::columns.
+ */
+SqlResultView<QVariantList> TagRepository::get_all_tag_rows() const {
+    auto query = QueryUtilities::get_sql_query(
+        "select_tags.sql",
+        this->get_connection_name()
+    );
+    return SqlResultView<QVariantList>(std::move(query));
+}
+
 bool TagRepository::update_name(const QString& new_name, const TagId& tag_id) const {
     return this->alter_database(
         "update_tag.sql",
-        {new_name, tag_id.toString()},
+        {new_name, tag_id},
         false,
         "#column_name#",
         "name"
@@ -70,7 +75,7 @@ bool TagRepository::update_color(const QColor& new_color, const TagId& tag_id) c
         "update_tag.sql",
         {
             new_color.isValid() ? new_color.name(QColor::HexArgb) : "",
-            tag_id.toString()
+            tag_id
         },
         false,
         "#column_name#",
@@ -82,8 +87,8 @@ bool TagRepository::update_parent(const TagId &new_parent_id, const TagId &tag_i
     return this->alter_database(
         "update_tag.sql",
         {
-            TagRepository::convert_id(new_parent_id),
-            tag_id.toString()
+            new_parent_id,
+            tag_id
         },
         false,
         "#column_name#",
@@ -95,12 +100,12 @@ bool TagRepository::save(const Tag& tag, const TagId& parent_id) const {
     return this->alter_database(
         "create_tag.sql",
         {
-            tag.get_uuid_string(),
+            tag.get_uuid(),
             tag.get_name(),
             tag.get_color().isValid()
                 ? tag.get_color().name(QColor::HexArgb)
                 : "",
-            TagRepository::convert_id(parent_id)
+            parent_id
         }
     );
 }
@@ -34,8 +34,6 @@ class TagRepository : public TransactionalRepository
 private:
     using TransactionalRepository::TransactionalRepository;
 
-    [[nodiscard]] static QVariant convert_id(const TagId& tag_id);
-
 public:
     static TagRepository create(const QString &database_connection_name);
 
@@ -47,6 +45,7 @@ public:
     };
 
     [[nodiscard]] SqlResultView<Tag> get_all_tags() const;
+    [[nodiscard]] SqlResultView<QVariantList> get_all_tag_rows() const;
     // NOLINTBEGIN (modernize-use-nodiscard)
     bool update_name(const QString& new_name, const TagId& tag_id) const;
     bool update_color(const QColor& new_color, const TagId& tag_id) const;
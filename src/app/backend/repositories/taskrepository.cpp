@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -22,10 +22,11 @@
 
 #include <QHash>
 #include <QList>
-#include <QMultiHash>
+#include <QPair>
 #include <QSet>
 #include <QSqlQuery>
 #include <QString>
+#include <QVariantList>
 #include <QtConcurrentMap>
 
 #include "dataitems/qtdid.h"
@@ -45,6 +46,17 @@ SqlResultView<Task> TaskRepository::get_all_tasks() const {
     return SqlResultView<Task>(std::move(query));
 }
 
+/**
+ * @brief The rows of get_all_tasks() without constructing tasks, for decoding them elsewhere.
+ */
+SqlResultView<QVariantList> TaskRepository::get_all_task_rows() const {
+    auto query = QueryUtilities::get_sql_query(
+        "select_tasks.sql",
+        this->get_connection_name()
+    );
+    return SqlResultView<QVariantList>(std::move(query));
+}
+
 QHash<TaskId, QSet<TagId>> TaskRepository::get_all_tag_assignments() const {
     QHash<TaskId, QSet<TagId>> result;
     auto query = QueryUtilities::get_sql_query(
@@ -59,15 +71,16 @@ QHash<TaskId, QSet<TagId>> TaskRepository::get_all_tag_assignments() const {
 
 /**
  * @brief Read dependencies from database
- * @return A mapping of tasks to the tasks that depend on them (children mapped to their parents)
+ * @return Pairs of tasks and the tasks that depend on them (children and their parents),
+ *         in the order in which the dependencies were created
  */
-QMultiHash<TaskId, TaskId> TaskRepository::get_all_dependencies() const {
-    QMultiHash<TaskId, TaskId> result;
+QList<QPair<TaskId, TaskId>> TaskRepository::get_all_dependencies() const {
+    QList<QPair<TaskId, TaskId>> result;
     auto query = QueryUtilities::get_sql_query("select_dependencies.sql", this->get_connection_name());
     while (query.next()) {
         // 0: dependent_uuid
         // 1: prerequisite_uuid
-        result.insert(query.value(1).value<TaskId>(), query.value(0).value<TaskId>());
+        result.append({query.value(1).value<TaskId>(), query.value(0).value<TaskId>()});
     }
     return result;
 }
@@ -76,7 +89,7 @@ bool TaskRepository::save(const Task& task) const {
     return this->alter_database(
         "create_task.sql",
         {
-            task.get_uuid_string(),
+            task.get_uuid(),
             task.get_title(),
             Task::status_to_string(task.get_status()),
             task.get_start_datetime(),
@@ -90,7 +103,7 @@ bool TaskRepository::add_prerequisites(const TaskId& dependent, const QList<QVar
     return this->alter_database(
         "create_dependency.sql",
         {
-            QVariant(QList<QVariant>(prerequisites.size(), dependent.toString())),
+            QVariant(QList<QVariant>(prerequisites.size(), dependent)),
             prerequisites
         },
         true
@@ -102,19 +115,28 @@ bool TaskRepository::add_dependents(const TaskId& prerequisite, const QList<QVar
         "create_dependency.sql",
         {
             dependents,
-            QVariant(QList<QVariant>(dependents.size(), prerequisite.toString()))
+            QVariant(QList<QVariant>(dependents.size(), prerequisite))
         },
         true
     );
 }
 
 bool TaskRepository::remove_prerequisites(const TaskId& dependent, const QList<QVariant>& prerequisites) const {
+    return this->remove_dependencies(QList<QVariant>(prerequisites.size(), dependent), prerequisites);
+}
+
+/**
+ * @brief Remove the dependencies of dependents[i] on prerequisites[i] in a single batch.
+ *
+ * Prerequisites that are left without any dependent are removed as well.
+ */
+bool TaskRepository::remove_dependencies(
+    const QList<QVariant>& dependents,
+    const QList<QVariant>& prerequisites
+) const {
     return this->alter_database(
         "delete_dependency.sql",
-        {
-            QVariant(QList<QVariant>(prerequisites.size(), dependent.toString())),
-            prerequisites
-        },
+        {dependents, prerequisites},
         true
     ) && this->remove_isolated(prerequisites);
 }
@@ -124,7 +146,7 @@ bool TaskRepository::remove_dependents(const TaskId& prerequisite, const QList<Q
         "delete_dependency.sql",
         {
             dependents,
-            QVariant(QList<QVariant>(dependents.size(), prerequisite.toString()))
+            QVariant(QList<QVariant>(dependents.size(), prerequisite))
         },
         true
         );
@@ -139,7 +161,7 @@ bool TaskRepository::update_column(
         "update_task.sql",
         {
             new_value,
-            task.toString()
+            task
         },
         false,
         "#column_name#",
@@ -174,28 +196,48 @@ bool TaskRepository::remove_isolated(const QList<QVariant>& task_ids) const {
         = QtConcurrent::blockingMapped(
               task_ids,
               [](const QVariant& uuid) {
-                  return uuid.toString();
+                  return "X'" + QString::fromLatin1(uuid.value<TaskId>().to_bytes().toHex()) + "'";
               }
-        ).join("', '");
-    return this->alter_database(
-        "delete_dangling_task.sql",
-        {},
-        false,
-        "#tasks_to_delete#",
-        "'" + formatted_ids + "'"
+        ).join(", ");
+    return this->alter_database_uncached(
+        QueryUtilities::get_sql_query_string("delete_dangling_task.sql")
+            .replace("#tasks_to_delete#", formatted_ids),
+        {}
     );
 }
 
 bool TaskRepository::add_tag(const TaskId& task, const TagId& tag) const {
     return this->alter_database(
         "add_tag_association.sql",
-        {task.toString(), tag.toString()}
+        {task, tag}
     );
 }
 
 bool TaskRepository::remove_tag(const TaskId& task, const TagId& tag) const {
     return this->alter_database(
         "remove_tag_association.sql",
-        {task.toString(), tag.toString()}
+        {task, tag}
+    );
+}
+
+/**
+ * @brief Assign tags[i] to tasks[i] for all i in a single batch.
+ */
+bool TaskRepository::add_tags(const QList<QVariant>& tasks, const QList<QVariant>& tags) const {
+    return this->alter_database(
+        "add_tag_association.sql",
+        {tasks, tags},
+        true
+    );
+}
+
+/**
+ * @brief Remove tags[i] from tasks[i] for all i in a single batch.
+ */
+bool TaskRepository::remove_tags(const QList<QVariant>& tasks, const QList<QVariant>& tags) const {
+    return this->alter_database(
+        "remove_tag_association.sql",
+        {tasks, tags},
+        true
     );
 }
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -22,8 +22,9 @@
 
 #include <QHash>
 #include <QList>
-#include <QMultiHash>
+#include <QPair>
 #include <QSet>
+#include <QVariantList>
 
 #include "dataitems/qtdid.h"
 #include "dataitems/task.h"
@@ -41,8 +42,9 @@ public:
     static TaskRepository create(const QString &database_connection_name);
 
     [[nodiscard]] SqlResultView<Task> get_all_tasks() const;
+    [[nodiscard]] SqlResultView<QVariantList> get_all_task_rows() const;
     [[nodiscard]] QHash<TaskId, QSet<TagId>> get_all_tag_assignments() const;
-    [[nodiscard]] QMultiHash<TaskId, TaskId> get_all_dependencies() const;
+    [[nodiscard]] QList<QPair<TaskId, TaskId>> get_all_dependencies() const;
 
     // NOLINTBEGIN (modernize-use-nodiscard)
     bool save(const Task& task) const;
@@ -52,8 +54,11 @@ public:
     bool add_dependents      (const TaskId& prerequisite, const QList<QVariant>& dependents   ) const;
     bool remove_prerequisites(const TaskId& dependent,    const QList<QVariant>& prerequisites) const;
     bool remove_dependents   (const TaskId& prerequisite, const QList<QVariant>& dependents   ) const;
+    bool remove_dependencies (const QList<QVariant>& dependents, const QList<QVariant>& prerequisites) const;
 
     bool add_tag   (const TaskId& task, const TagId& tag) const;
     bool remove_tag(const TaskId& task, const TagId& tag) const;
+    bool add_tags   (const QList<QVariant>& tasks, const QList<QVariant>& tags) const;
+    bool remove_tags(const QList<QVariant>& tasks, const QList<QVariant>& tags) const;
     // NOLINTEND (modernize-use-nodiscard)
 };
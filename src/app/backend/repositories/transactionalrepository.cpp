@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -21,31 +21,93 @@
 #include <initializer_list>
 #include <stdexcept>
 
+#include <QByteArray>
+#include <QHash>
+#include <QMetaType>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QSqlDatabase>
 #include <QSqlQuery>
+#include <QVariant>
+#include <QVariantList>
 
+#include "dataitems/qtdid.h"
+#include "statementcache.h"
 #include "utils/query_utilities.h"
 
+namespace {
+
+/**
+ * @brief Convert an id to its binary database representation; invalid ids are stored as NULL.
+ */
+QVariant to_sql_value(const QVariant& value) {
+    if (value.metaType() != QMetaType::fromType<QtdId>()) {
+        return value;
+    }
+    const auto id = value.value<QtdId>();
+    return id.is_valid() ? QVariant(id.to_bytes()) : QVariant(QMetaType::fromType<QByteArray>());
+}
+
+/**
+ * @brief Convert a bind value or a list of bind values (used for batch execution).
+ */
+QVariant to_sql_bind_value(const QVariant& value) {
+    if (value.metaType() != QMetaType::fromType<QVariantList>()) {
+        return to_sql_value(value);
+    }
+    auto values = value.toList();
+    for (auto& element : values) {
+        element = to_sql_value(element);
+    }
+    return values;
+}
+
+QMutex transaction_mutex;
+
+/**
+ * @brief Connections with an open transaction, mapped to whether any participant requested a rollback
+ */
+QHash<QString, bool> open_transactions; // NOLINT (cppcoreguidelines-avoid-non-const-global-variables)
+
+} // anonymous namespace
+
 /**
  * @class TransactionalRepository
  * @brief RAII base class for database repositories
  *
  * Transactions are automatically started and should be rolled back
- * on failure.
+ * on failure. A repository created while another one holds a transaction
+ * on the same connection joins that transaction: it is committed or
+ * rolled back as a whole when the outermost repository is destroyed.
  */
 
 TransactionalRepository::TransactionalRepository(
     const QString &database_connection_name
-) : connection_name(database_connection_name), rollback_requested(false)
+) : connection_name(database_connection_name), rollback_requested(false), joined_transaction(false)
 {
+    const QMutexLocker locker(&transaction_mutex);
+    this->joined_transaction = open_transactions.contains(database_connection_name);
+    if (this->joined_transaction) {
+        return;
+    }
     if (!QSqlDatabase::database(database_connection_name).transaction()) {
         throw std::runtime_error("Failed to initialize a database transaction.");
     }
+    open_transactions.insert(database_connection_name, false);
 }
 
 TransactionalRepository::~TransactionalRepository() {
+    if (this->joined_transaction) {
+        return;
+    }
+    bool rollback_requested = this->rollback_requested;
+    {
+        const QMutexLocker locker(&transaction_mutex);
+        rollback_requested |= open_transactions.take(this->connection_name);
+    }
+
     auto database = QSqlDatabase::database(this->connection_name);
-    if (this->rollback_requested) {
+    if (rollback_requested) {
         database.rollback();
     } else {
         database.commit();
@@ -54,6 +116,10 @@ TransactionalRepository::~TransactionalRepository() {
 
 void TransactionalRepository::roll_back() {
     this->rollback_requested = true;
+    if (this->joined_transaction) {
+        const QMutexLocker locker(&transaction_mutex);
+        open_transactions[this->connection_name] = true;
+    }
 }
 
 bool TransactionalRepository::roll_back_on_failure(bool execution_result) {
@@ -67,6 +133,26 @@ const QString& TransactionalRepository::get_connection_name() const {
     return this->connection_name;
 }
 
+bool TransactionalRepository::bind_and_execute(
+    QSqlQuery& query,
+    std::initializer_list<QVariant> bind_values,
+    bool batch
+) {
+    int value_index = -1;
+    for (const auto& value : bind_values) {
+        query.bindValue(++value_index, to_sql_bind_value(value));
+    }
+    const bool success = QueryUtilities::execute_sql_query(query, batch);
+    query.finish();
+    return success;
+}
+
+/**
+ * @brief Execute the statement of an SQL file with the given bind values.
+ *
+ * The statement is taken from the StatementCache of the connection. The replacement
+ * must therefore only be used for a small set of strings, e.g. column names.
+ */
 bool TransactionalRepository::alter_database(
     const QString& sql_file_name,
     std::initializer_list<QVariant> bind_values,
@@ -74,19 +160,24 @@ bool TransactionalRepository::alter_database(
     const QString& replace_pattern,
     const QString& replace_string
 ) const {
-    auto query_str = QueryUtilities::get_sql_query_string(sql_file_name);
-    if (!replace_pattern.isEmpty()) {
-        query_str = query_str.replace(replace_pattern, replace_string);
-    }
+    const auto query = StatementCache::get_query(
+        this->connection_name,
+        sql_file_name,
+        replace_pattern,
+        replace_string
+    );
+    return query != nullptr && TransactionalRepository::bind_and_execute(*query, bind_values, batch);
+}
 
+/**
+ * @brief Prepare and execute a statement that is not reused, e.g. one with inlined values.
+ */
+bool TransactionalRepository::alter_database_uncached(
+    const QString& query_string,
+    std::initializer_list<QVariant> bind_values,
+    bool batch
+) const {
     auto query = QSqlQuery(QSqlDatabase::database(this->connection_name));
-    if (!query.prepare(query_str)) {
-        return false;
-    }
-
-    int value_index = -1;
-    for (const auto& value : bind_values) {
-        query.bindValue(++value_index, value);
-    }
-    return QueryUtilities::execute_sql_query(query, batch);
+    return query.prepare(query_string)
+           && TransactionalRepository::bind_and_execute(query, bind_values, batch);
 }
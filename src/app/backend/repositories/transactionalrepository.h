@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -28,6 +28,13 @@ class TransactionalRepository
 private:
     QString connection_name;
     bool rollback_requested;
+    bool joined_transaction;
+
+    static bool bind_and_execute(
+        QSqlQuery& query,
+        std::initializer_list<QVariant> bind_values,
+        bool batch
+    );
 
 protected:
     explicit TransactionalRepository(const QString& database_connection_name);
@@ -41,6 +48,12 @@ protected:
         const QString& replace_pattern = "",
         const QString& replace_string = ""
     ) const;
+    // NOLINTNEXTLINE (modernize-use-nodiscard)
+    bool alter_database_uncached(
+        const QString& query_string,
+        std::initializer_list<QVariant> bind_values,
+        bool batch = false
+    ) const;
 
 public:
     TransactionalRepository(const TransactionalRepository&)             = delete;
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <algorithm>
+#include <bit>
+
+#include <QVarLengthArray>
+#include <QtTypes>
+
+/**
+ * @brief A set of small non-negative integers stored as one bit per integer.
+ *
+ * Intersection tests and unions work on whole 64 bit words. The first word is stored
+ * inline, so sets of integers below 64 need no heap allocation. Trailing zero words
+ * are never stored, which keeps the comparison of two sets a plain word comparison.
+ */
+class DenseBitset
+{
+private:
+    static constexpr qsizetype bits_per_word = 64;
+
+    QVarLengthArray<quint64, 1> words;
+
+    void trim() {
+        while (!this->words.isEmpty() && this->words.last() == 0) {
+            this->words.removeLast();
+        }
+    }
+
+public:
+    void set(qsizetype bit) {
+        const auto word = bit / bits_per_word;
+        if (word >= this->words.size()) {
+            this->words.resize(word + 1, 0);
+        }
+        this->words[word] |= quint64{1} << (bit % bits_per_word);
+    }
+
+    void reset(qsizetype bit) {
+        const auto word = bit / bits_per_word;
+        if (word < this->words.size()) {
+            this->words[word] &= ~(quint64{1} << (bit % bits_per_word));
+            this->trim();
+        }
+    }
+
+    [[nodiscard]] bool test(qsizetype bit) const {
+        const auto word = bit / bits_per_word;
+        return word < this->words.size() && (this->words.at(word) & (quint64{1} << (bit % bits_per_word))) != 0;
+    }
+
+    [[nodiscard]] bool is_empty() const {
+        return this->words.isEmpty();
+    }
+
+    [[nodiscard]] bool intersects(const DenseBitset& other) const {
+        const auto word_count = std::min(this->words.size(), other.words.size());
+        for (qsizetype i=0; i<word_count; i++) {
+            if ((this->words.at(i) & other.words.at(i)) != 0) {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    DenseBitset& operator|=(const DenseBitset& other) {
+        if (other.words.size() > this->words.size()) {
+            this->words.resize(other.words.size(), 0);
+        }
+        for (qsizetype i=0; i<other.words.size(); i++) {
+            this->words[i] |= other.words.at(i);
+        }
+        return *this;
+    }
+
+    bool operator==(const DenseBitset& other) const {
+        return this->words == other.words;
+    }
+
+    /**
+     * @brief Call a function with every integer in the set in ascending order.
+     */
+    template <typename Function>
+    void for_each(Function function) const {
+        for (qsizetype i=0; i<this->words.size(); i++) {
+            for (auto word = this->words.at(i); word != 0; word &= word - 1) {
+                function(i * bits_per_word + std::countr_zero(word));
+            }
+        }
+    }
+};
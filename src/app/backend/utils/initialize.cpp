@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -18,6 +18,7 @@
 
 #include "initialize.h"
 
+#include <QByteArray>
 #include <QMetaType>
 #include <QString>
 
@@ -27,4 +28,6 @@ void initialize_qt_meta_types() {
     qRegisterMetaType<QtdId>("QtdId");
     QMetaType::registerConverter<QString, QtdId>();
     QMetaType::registerConverter<QtdId, QString>();
+    QMetaType::registerConverter<QByteArray, QtdId>(&QtdId::from_bytes);
+    QMetaType::registerConverter<QtdId, QByteArray>(&QtdId::to_bytes);
 }
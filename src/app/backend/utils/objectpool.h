@@ -0,0 +1,114 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A slab allocator for objects of a single type.
+ *
+ * Objects are constructed in slabs of many objects each. This reduces the number of heap
+ * allocations and keeps objects that are created one after another close to each other
+ * in memory. The address of an object is stable until it is destroyed, after which its
+ * slot is reused for the next object. All objects must be destroyed before the pool.
+ */
+template <typename T>
+class ObjectPool
+{
+private:
+    static constexpr std::size_t slab_size = 256;
+
+    union Slot {
+        Slot* next_free;
+        alignas(T) std::array<std::byte, sizeof(T)> storage;
+    };
+
+    std::vector<std::unique_ptr<Slot[]>> slabs; // NOLINT(cppcoreguidelines-avoid-c-arrays)
+    std::size_t unused_slots_in_last_slab = 0;
+    Slot* free_slots = nullptr;
+    std::size_t object_count = 0;
+
+    Slot* allocate_slot() {
+        if (this->free_slots != nullptr) {
+            auto* slot = this->free_slots;
+            this->free_slots = slot->next_free;
+            return slot;
+        }
+        if (this->unused_slots_in_last_slab == 0) {
+            this->slabs.push_back(std::make_unique<Slot[]>(slab_size)); // NOLINT(cppcoreguidelines-avoid-c-arrays)
+            this->unused_slots_in_last_slab = slab_size;
+        }
+        return &this->slabs.back()[slab_size - this->unused_slots_in_last_slab--];
+    }
+
+    void release_slot(Slot* slot) {
+        slot->next_free = this->free_slots;
+        this->free_slots = slot;
+    }
+
+public:
+    ObjectPool() = default;
+    ObjectPool(const ObjectPool&)            = delete;
+    ObjectPool(ObjectPool&&)                 = delete;
+    ObjectPool& operator=(const ObjectPool&) = delete;
+    ObjectPool& operator=(ObjectPool&&)      = delete;
+    ~ObjectPool() = default;
+
+    template <typename... Args>
+    T* create(Args&&... args) {
+        auto* slot = this->allocate_slot();
+        T* result = nullptr;
+        try {
+            result = ::new (static_cast<void*>(slot->storage.data())) T(std::forward<Args>(args)...);
+        } catch (...) {
+            this->release_slot(slot);
+            throw;
+        }
+        this->object_count++;
+        return result;
+    }
+
+    void destroy(T* object) {
+        if (object == nullptr) {
+            return;
+        }
+        object->~T();
+        this->release_slot(reinterpret_cast<Slot*>(object)); // NOLINT(cppcoreguidelines-pro-type-reinterpret-cast)
+        this->object_count--;
+    }
+
+    /**
+     * @brief Returns the number of objects that have been created but not destroyed yet.
+     */
+    [[nodiscard]] std::size_t size() const {
+        return this->object_count;
+    }
+
+    /**
+     * @brief Returns the number of objects that fit into the slabs allocated so far.
+     */
+    [[nodiscard]] std::size_t capacity() const {
+        return this->slabs.size() * slab_size;
+    }
+};
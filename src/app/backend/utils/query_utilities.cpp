@@ -22,15 +22,22 @@
 
 #include <QAbstractItemModel>
 #include <QFile>
+#include <QHash>
+#include <QMutex>
+#include <QMutexLocker>
 #include <QRegularExpression>
 #include <QSqlDatabase>
 #include <QSqlError>
 #include <QSqlQuery>
+#include <QSqlRecord>
 #include <QString>
 #include <QStringList>
 #include <QTextStream>
+#include <QVariant>
 #include <QtLogging>
 
+#include "dataitems/qtdid.h"
+
 namespace QueryUtilities {
 
 /**
@@ -48,10 +55,22 @@ QString remove_sql_comments(QString queries) {
     return queries.remove(QRegularExpression(comment_regex));
 }
 
+/**
+ * @brief Read an SQL resource file without comments; every file is read and processed only once.
+ */
 QString get_sql_query_string(const QString& sql_filename) {
+    static QMutex mutex;
+    static QHash<QString, QString> query_strings;
+
+    const QMutexLocker locker(&mutex);
+    const auto cached = query_strings.constFind(sql_filename);
+    if (cached != query_strings.cend()) {
+        return *cached;
+    }
+
     QFile file(":/resources/sql/generic/" + sql_filename);
     file.open(QFile::ReadOnly | QFile::Text);
-    return remove_sql_comments(QTextStream(&file).readAll());
+    return *query_strings.insert(sql_filename, remove_sql_comments(QTextStream(&file).readAll()));
 }
 
 QSqlQuery get_sql_query(const QString& sql_filename, const QString& connection_name) {
@@ -70,16 +89,103 @@ bool execute_sql_query(QSqlQuery& query, bool batch) {
     return true;
 }
 
+namespace {
+
+bool execute_sql_file(QSqlQuery& query, const QString& sql_filename) {
+    bool no_error = true;
+    for (const QString& query_str : split_queries(get_sql_query_string(sql_filename))) {
+        no_error &= query.exec(query_str);
+    }
+    return no_error;
+}
+
+/**
+ * @brief Check whether the database was created with a schema that stores ids as text.
+ */
+bool uses_text_ids(const QSqlDatabase& connection) {
+    QSqlQuery query("SELECT type FROM pragma_table_info('tasks') WHERE name = 'uuid';", connection);
+    return query.next() && query.value(0).toString().startsWith("VARCHAR");
+}
+
+/**
+ * @brief Copy the rows of a table renamed by migrate_text_ids_prepare.sql into the new table.
+ *
+ * Text ids are converted to their binary representation; invalid ids become NULL.
+ */
+bool copy_and_convert_text_ids(
+    const QSqlDatabase& connection,
+    const QString& table_name,
+    const QStringList& id_columns
+) {
+    QSqlQuery select_query(connection);
+    // Rows are copied in insertion order, which determines the order of sibling tasks:
+    if (!select_query.exec(QString("SELECT * FROM %1_text_ids ORDER BY rowid;").arg(table_name))) {
+        return false;
+    }
+
+    const auto record = select_query.record();
+    QStringList column_names;
+    for (int i=0; i<record.count(); i++) {
+        column_names << record.fieldName(i);
+    }
+
+    QSqlQuery insert_query(connection);
+    const QString insert_query_str = QString("INSERT INTO %1 (%2) VALUES (%3);").arg(
+        table_name,
+        column_names.join(", "),
+        QStringList(column_names.size(), "?").join(", ")
+    );
+    if (!insert_query.prepare(insert_query_str)) {
+        return false;
+    }
+
+    while (select_query.next()) {
+        for (int i=0; i<record.count(); i++) {
+            auto value = select_query.value(i);
+            if (id_columns.contains(column_names.at(i))) {
+                const QtdId id(value.toString());
+                value = id.is_valid() ? QVariant(id.to_bytes()) : QVariant();
+            }
+            insert_query.bindValue(i, value);
+        }
+        if (!execute_sql_query(insert_query)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+bool migrate_text_ids(QSqlQuery& query, const QSqlDatabase& connection) {
+    return copy_and_convert_text_ids(connection, "tags",            {"uuid", "parent_uuid"})
+        && copy_and_convert_text_ids(connection, "tasks",           {"uuid"})
+        && copy_and_convert_text_ids(connection, "task_media",      {"task_uuid"})
+        && copy_and_convert_text_ids(connection, "tag_assignments", {"task_uuid", "tag_uuid"})
+        && copy_and_convert_text_ids(connection, "dependencies",    {"dependent_uuid", "prerequisite_uuid"})
+        && execute_sql_file(query, "migrate_text_ids_cleanup.sql");
+}
+
+} // anonymous namespace
+
+/**
+ * @brief Create all tables that do not exist yet.
+ *
+ * Databases that still store ids as text are migrated to binary ids
+ * within the same transaction.
+ */
 bool create_tables_if_not_exist(const QString& connection_name) {
     // The "if not exist"-part is governed by the SQL commands.
-    const QString all_queries_str = get_sql_query_string("create_tables.sql");
     auto connection = QSqlDatabase::database(connection_name);
+    const bool migrate_ids = uses_text_ids(connection);
 
     QSqlQuery query(connection);
     bool no_error = connection.transaction();
     no_error &= query.exec("PRAGMA foreign_keys = ON;");
-    for (const QString& query_str : split_queries(all_queries_str)) {
-        no_error &= query.exec(query_str);
+    if (migrate_ids) {
+        no_error &= execute_sql_file(query, "migrate_text_ids_prepare.sql");
+    }
+    no_error &= execute_sql_file(query, "create_tables.sql");
+    if (migrate_ids) {
+        no_error &= migrate_text_ids(query, connection);
     }
 
     no_error ? connection.commit() : connection.rollback();
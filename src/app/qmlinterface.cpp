@@ -18,24 +18,54 @@
 
 #include "qmlinterface.h"
 
-#include <functional>
 #include <utility>
 
 #include <QCoreApplication>
 #include <QDir>
+#include <QElapsedTimer>
+#include <QSignalBlocker>
 #include <QSqlDatabase>
 #include <QStandardPaths>
 #include <QString>
+#include <QtLogging>
 
 #include "backend/models/filteredtagitemmodel.h"
 #include "backend/models/filteredtaskitemmodel.h"
 #include "backend/models/flatteningproxymodel.h"
 #include "backend/models/mainpagemodelfilter.h"
 #include "backend/models/tagitemmodel.h"
+#include "backend/models/taskcolumnstore.h"
 #include "backend/models/taskitemmodel.h"
+#include "backend/repositories/databaseworker.h"
+#include "backend/repositories/persistencequeue.h"
+#include "backend/repositories/startuploader.h"
+#include "backend/repositories/statementcache.h"
 #include "backend/utils/query_utilities.h"
 #include "globaleventfilter.h"
 
+QmlInterface::QmlInterface(QObject* parent)
+    : QObject{parent}
+{}
+
+/**
+ * @brief Write the remaining changes and close the connection after releasing its statements.
+ *
+ * The models are not reloaded anymore if writing fails, so the failure is only logged.
+ */
+QmlInterface::~QmlInterface() {
+    if (this->m_persistence_queue != nullptr) {
+        const QSignalBlocker blocker(this->m_persistence_queue);
+        if (!this->m_persistence_queue->flush()) {
+            qWarning("Some changes could not be written to the database on shutdown.");
+        }
+    }
+    // NOLINTBEGIN(cppcoreguidelines-owning-memory)
+    delete this->m_persistence_queue;
+    delete this->m_database_worker;
+    // NOLINTEND(cppcoreguidelines-owning-memory)
+    StatementCache::close_connection(this->local_connection_name);
+}
+
 void QmlInterface::open_database(
     const QString& database_file_path,
     const QString& connection_name
@@ -55,7 +85,8 @@ void QmlInterface::open_database(
 void QmlInterface::set_up_filtered_model(
     FilteredTagItemModel*& tag_model,
     FilteredTaskItemModel*& task_model,
-    std::function<bool (const QModelIndex &)> filter
+    FilteredTaskItemModel::TaskFilterFunction filter,
+    TaskColumnStore::Filter column_filter
 ) {
     // NOLINTBEGIN(cppcoreguidelines-owning-memory,misc-include-cleaner)
     tag_model = new FilteredTagItemModel(this);
@@ -72,17 +103,36 @@ void QmlInterface::set_up_filtered_model(
     );
 
     tag_model->setSourceModel(this->m_tags);
+    task_model->set_search_index(this->m_tasks->get_search_index());
+    task_model->set_column_filter(this->m_tasks->get_column_store(), column_filter);
+    task_model->set_filter_roles(task_filter_roles);
     task_model->setSourceModel(this->m_tasks);
 }
 
 void QmlInterface::set_up_core_models(const QString& connection_name) {
+    auto snapshot = StartupLoader::load(connection_name);
+    QElapsedTimer assembly_timer;
+    assembly_timer.start();
+
     // NOLINTBEGIN(cppcoreguidelines-owning-memory)
-    this->m_tags      = new TagItemModel(connection_name, this);
+    this->m_tags      = new TagItemModel(connection_name, std::move(snapshot.tags), this);
     this->m_flat_tags = new FlatteningProxyModel(this);
-    this->m_tasks     = new TaskItemModel(connection_name, this);
+    this->m_tasks     = new TaskItemModel(connection_name, std::move(snapshot.task_data), this);
+    // The queue is destroyed first and writes its remaining operations through the worker:
+    this->m_persistence_queue = new PersistenceQueue(connection_name, this);
+    this->m_database_worker   = new DatabaseWorker(connection_name, this);
     // NOLINTEND(cppcoreguidelines-owning-memory)
 
+    this->m_persistence_queue->set_database_worker(this->m_database_worker);
+    // Tags and tasks share the queue, so that all writes use the worker's connection in order:
+    this->m_tags->set_persistence_queue(this->m_persistence_queue);
+    this->m_tasks->set_persistence_queue(this->m_persistence_queue);
+    // Edits of cloned items are announced once per event loop iteration:
+    this->m_tags->set_change_coalescing(true);
+    this->m_tasks->set_change_coalescing(true);
+
     this->m_flat_tags->setSourceModel(this->m_tags);
+    StartupLoader::log_durations(snapshot, assembly_timer.elapsed());
 }
 
 void QmlInterface::set_up_models(const QString& connection_name) {
@@ -91,22 +141,26 @@ void QmlInterface::set_up_models(const QString& connection_name) {
     this->set_up_filtered_model(
         this->m_tags_open,
         this->m_open_tasks,
-        is_task_open
+        is_task_open,
+        open_task_filter
     );
     this->set_up_filtered_model(
         this->m_tags_actionable,
         this->m_actionable_tasks,
-        is_task_actionable
+        is_task_actionable,
+        actionable_task_filter
     );
     this->set_up_filtered_model(
         this->m_tags_project,
         this->m_project_tasks,
-        is_task_in_open_project
+        is_task_in_open_project,
+        open_project_filter
     );
     this->set_up_filtered_model(
         this->m_tags_archived,
         this->m_archived_tasks,
-        is_task_closed
+        is_task_closed,
+        closed_task_filter
     );
 }
 
@@ -124,8 +178,7 @@ void QmlInterface::set_up_event_filter() {
 void QmlInterface::set_up(const QString& database_file_path) {
     this->m_application_dir = QCoreApplication::applicationDirPath();
 
-    const QString connection_name = "local";
-    this->open_database(database_file_path, connection_name);
-    this->set_up_models(connection_name);
+    this->open_database(database_file_path, this->local_connection_name);
+    this->set_up_models(this->local_connection_name);
     this->set_up_event_filter();
 }
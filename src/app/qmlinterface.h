@@ -18,9 +18,6 @@
 
 #pragma once
 
-#include <functional>
-
-#include <QModelIndex>
 #include <QObject>
 #include <QQmlEngine>
 
@@ -29,7 +26,10 @@
 #include "backend/models/filteredtaskitemmodel.h"
 #include "backend/models/flatteningproxymodel.h"
 #include "backend/models/tagitemmodel.h"
+#include "backend/models/taskcolumnstore.h"
 #include "backend/models/taskitemmodel.h"
+#include "backend/repositories/databaseworker.h"
+#include "backend/repositories/persistencequeue.h"
 #include "globaleventfilter.h"
 
 class QmlInterface : public QObject
@@ -40,6 +40,7 @@ class QmlInterface : public QObject
 
 private:
     const QString          local_database_name = "qtd.sqlite";
+    const QString          local_connection_name = "local";
     QString                m_application_dir;
     TagItemModel*          m_tags;
     FilteredTagItemModel*  m_tags_open;
@@ -48,6 +49,8 @@ private:
     FilteredTagItemModel*  m_tags_archived;
     FlatteningProxyModel*  m_flat_tags;
     TaskItemModel*         m_tasks;
+    PersistenceQueue*      m_persistence_queue = nullptr;
+    DatabaseWorker*        m_database_worker = nullptr;
     FilteredTaskItemModel* m_open_tasks;
     FilteredTaskItemModel* m_actionable_tasks;
     FilteredTaskItemModel* m_project_tasks;
@@ -61,7 +64,8 @@ private:
     void set_up_filtered_model(
         FilteredTagItemModel*& tag_model,
         FilteredTaskItemModel*& task_model,
-        std::function<bool(const QModelIndex&)> filter
+        FilteredTaskItemModel::TaskFilterFunction filter,
+        TaskColumnStore::Filter column_filter
     );
     void set_up_core_models(const QString& connection_name);
     void set_up_models(const QString& connection_name);
@@ -89,5 +93,12 @@ public:
 
     Q_PROPERTY(GlobalEventFilter*    global_event_filter   MEMBER m_global_event_filter   CONSTANT)
 
+    explicit QmlInterface(QObject* parent = nullptr);
+    QmlInterface(const QmlInterface&)            = delete;
+    QmlInterface(QmlInterface&&)                 = delete;
+    QmlInterface& operator=(const QmlInterface&) = delete;
+    QmlInterface& operator=(QmlInterface&&)      = delete;
+    ~QmlInterface() override;
+
     void set_up(const QString& database_file_path = "");
 };
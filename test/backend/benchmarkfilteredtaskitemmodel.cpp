@@ -0,0 +1,154 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkfilteredtaskitemmodel.h"
+
+#include <memory>
+#include <vector>
+
+#include <QModelIndex>
+#include <QString>
+#include <QTest>
+
+#include "dataitems/qtdid.h"
+#include "dataitems/task.h"
+#include "models/filteredtaskitemmodel.h"
+#include "models/mainpagemodelfilter.h"
+#include "models/taskcolumnstore.h"
+#include "models/tasksearchindex.h"
+#include "utils/initialize.h"
+#include "utils/modeliteration.h"
+
+namespace {
+
+/**
+ * @brief Number of children of every non-leaf task in the generated task tree
+ */
+constexpr int branching_factor = 8;
+
+} // anonymous namespace
+
+
+BenchmarkFilteredTaskItemModel::BenchmarkFilteredTaskItemModel(QObject *parent)
+    : QObject{parent}
+{}
+
+void BenchmarkFilteredTaskItemModel::initTestCase() {
+    initialize_qt_meta_types();
+}
+
+void BenchmarkFilteredTaskItemModel::initTestCase_data() {
+    QTest::addColumn<int>("task_count");
+    QTest::newRow("10k tasks")  <<  10000;
+    QTest::newRow("50k tasks")  <<  50000;
+    QTest::newRow("100k tasks") << 100000;
+}
+
+void BenchmarkFilteredTaskItemModel::init() {
+    QFETCH_GLOBAL(int, task_count);
+
+    // The benchmarks do not modify the base model, so it is shared by all of them:
+    this->model.reset();
+    if (task_count != this->base_model_task_count) {
+        this->column_store.reset();
+        this->search_index.reset();
+        this->base_model = std::make_unique<TreeItemModelTestWrapper>();
+        std::vector<TaskId> task_ids;
+        task_ids.reserve(task_count);
+        for (int i=0; i<task_count; i++) {
+            auto task = std::make_unique<Task>(QString("Task %1").arg(i));
+            task_ids.push_back(task->get_uuid());
+            const auto parent_id = (i == 0) ? TaskId() : task_ids.at((i - 1) / branching_factor);
+            QVERIFY(this->base_model->create_tree_node(std::move(task), parent_id));
+        }
+        this->search_index = std::make_unique<TaskSearchIndex>(this->base_model.get());
+        this->column_store = std::make_unique<TaskColumnStore>(this->base_model.get());
+        this->base_model_task_count = task_count;
+    }
+
+    this->model = std::make_unique<FilteredTaskItemModel>();
+    this->model->setSourceModel(this->base_model.get());
+}
+
+void BenchmarkFilteredTaskItemModel::benchmark_rebuild_index_mapping() const {
+    QBENCHMARK {
+        this->model->set_search_string("Task");
+    }
+    QCOMPARE(this->model->rowCount(), 1);
+}
+
+void BenchmarkFilteredTaskItemModel::benchmark_selective_search_data() const {
+    QTest::addColumn<bool>("use_search_index");
+    QTest::newRow("without index") << false;
+    QTest::newRow("with index")    << true;
+}
+
+void BenchmarkFilteredTaskItemModel::benchmark_selective_search() const {
+    QFETCH(bool, use_search_index);
+    this->model->set_search_index(use_search_index ? this->search_index.get() : nullptr);
+
+    QBENCHMARK {
+        this->model->set_search_string("\"Task 4242\"");
+    }
+    QVERIFY(this->model->rowCount() > 0);
+}
+
+void BenchmarkFilteredTaskItemModel::benchmark_actionable_filter_data() const {
+    QTest::addColumn<bool>("use_column_store");
+    QTest::newRow("filter function") << false;
+    QTest::newRow("column store")    << true;
+}
+
+void BenchmarkFilteredTaskItemModel::benchmark_actionable_filter() const {
+    QFETCH(bool, use_column_store);
+    FilteredTaskItemModel actionable_model(is_task_actionable);
+    if (use_column_store) {
+        actionable_model.set_column_filter(this->column_store.get(), actionable_task_filter);
+    }
+    actionable_model.setSourceModel(this->base_model.get());
+
+    QBENCHMARK {
+        actionable_model.clear_search_string();
+    }
+    QVERIFY(actionable_model.rowCount() > 0);
+}
+
+void BenchmarkFilteredTaskItemModel::benchmark_map_from_source() const {
+    QBENCHMARK {
+        ModelIteration::model_foreach(
+            *this->base_model,
+            [this](const QModelIndex& source_index) {
+                const auto proxy_index = this->model->mapFromSource(source_index);
+                Q_UNUSED(this->model->mapToSource(proxy_index));
+            }
+        );
+    }
+}
+
+void BenchmarkFilteredTaskItemModel::benchmark_parent() const {
+    QBENCHMARK {
+        ModelIteration::model_foreach(
+            *this->model,
+            [this](const QModelIndex& proxy_index) {
+                Q_UNUSED(this->model->parent(proxy_index));
+            }
+        );
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchmarkFilteredTaskItemModel)
@@ -0,0 +1,63 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <QObject>
+#include <QTest>
+
+#include "models/filteredtaskitemmodel.h"
+#include "models/taskcolumnstore.h"
+#include "models/tasksearchindex.h"
+#include "testmodelwrappers.h"
+
+class BenchmarkFilteredTaskItemModel : public QObject
+{
+    Q_OBJECT
+
+private:
+    std::unique_ptr<TreeItemModelTestWrapper> base_model;
+    std::unique_ptr<TaskSearchIndex> search_index;
+    std::unique_ptr<TaskColumnStore> column_store;
+    std::unique_ptr<FilteredTaskItemModel> model;
+
+    /**
+     * @brief Size of the current base model; it is only rebuilt when the size changes.
+     */
+    int base_model_task_count = 0;
+
+public:
+    explicit BenchmarkFilteredTaskItemModel(QObject *parent = nullptr);
+
+private slots:
+    // Test setup/cleanup:
+    static void initTestCase();
+    static void initTestCase_data();
+    void init();
+
+    // Benchmark functions:
+    void benchmark_rebuild_index_mapping() const;
+    void benchmark_selective_search_data() const;
+    void benchmark_selective_search() const;
+    void benchmark_actionable_filter_data() const;
+    void benchmark_actionable_filter() const;
+    void benchmark_map_from_source() const;
+    void benchmark_parent() const;
+};
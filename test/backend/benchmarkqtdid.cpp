@@ -0,0 +1,86 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarkqtdid.h"
+
+#include <QHash>
+#include <QSet>
+#include <QTest>
+
+#include "dataitems/qtdid.h"
+
+namespace {
+
+constexpr int id_count = 100000;
+
+} // anonymous namespace
+
+
+BenchmarkQtdId::BenchmarkQtdId(QObject *parent)
+    : QObject{parent}
+{}
+
+void BenchmarkQtdId::initTestCase() {
+    this->ids.reserve(id_count);
+    for (int i=0; i<id_count; i++) {
+        this->ids.push_back(QtdId::create());
+    }
+}
+
+void BenchmarkQtdId::benchmark_hash_insert() const {
+    QBENCHMARK {
+        QHash<QtdId, int> hash;
+        for (int i=0; i<id_count; i++) {
+            hash.insert(this->ids.at(i), i);
+        }
+    }
+}
+
+void BenchmarkQtdId::benchmark_hash_lookup() const {
+    QHash<QtdId, int> hash;
+    for (int i=0; i<id_count; i++) {
+        hash.insert(this->ids.at(i), i);
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (const auto& id : this->ids) {
+            found += static_cast<int>(hash.contains(id));
+        }
+    }
+    QCOMPARE(found, id_count);
+}
+
+void BenchmarkQtdId::benchmark_set_intersection() const {
+    QSet<QtdId> even_ids;
+    QSet<QtdId> all_ids;
+    for (int i=0; i<id_count; i++) {
+        all_ids.insert(this->ids.at(i));
+        if (i % 2 == 0) {
+            even_ids.insert(this->ids.at(i));
+        }
+    }
+
+    QBENCHMARK {
+        QVERIFY(all_ids.intersects(even_ids));
+        QCOMPARE(QSet<QtdId>(all_ids).intersect(even_ids).size(), even_ids.size());
+    }
+}
+
+QTEST_GUILESS_MAIN(BenchmarkQtdId)
@@ -0,0 +1,108 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarktask.h"
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+#include <QDebug>
+#include <QObject>
+#include <QString>
+#include <QTest>
+#include <QtTypes>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "dataitems/task.h"
+
+namespace {
+
+constexpr int task_count = 100000;
+
+/**
+ * @brief The layout of a task back when Task derived from QObject, for comparison.
+ */
+class QObjectTask : public QObject, public Task {
+public:
+    explicit QObjectTask(const QString& title) : QObject(nullptr), Task(title) {}
+};
+
+template <typename T>
+std::vector<std::unique_ptr<T>> create_tasks() {
+    std::vector<std::unique_ptr<T>> result;
+    result.reserve(task_count);
+    for (int i=0; i<task_count; i++) {
+        result.push_back(std::make_unique<T>(QString("Task %1").arg(i)));
+    }
+    return result;
+}
+
+#ifdef __GLIBC__
+/**
+ * @brief Returns the number of heap bytes held by task_count tasks of the given type.
+ *
+ * Unlike the resident set size, the allocated heap is not distorted by memory that has
+ * been freed by a previous measurement but not returned to the operating system.
+ */
+template <typename T>
+qint64 measure_heap_usage() {
+    std::vector<std::unique_ptr<T>> tasks;
+    const auto heap_before = mallinfo2().uordblks;
+    tasks = create_tasks<T>();
+    const auto heap_after = mallinfo2().uordblks;
+    return static_cast<qint64>(heap_after - heap_before);
+}
+#endif
+
+} // anonymous namespace
+
+
+BenchmarkTask::BenchmarkTask(QObject *parent)
+    : QObject{parent}
+{}
+
+void BenchmarkTask::benchmark_create_tasks() {
+    std::size_t created_tasks = 0;
+    QBENCHMARK {
+        created_tasks = create_tasks<Task>().size();
+    }
+    QCOMPARE(created_tasks, std::size_t{task_count});
+}
+
+void BenchmarkTask::benchmark_heap_usage() {
+    qInfo().noquote() << QString("Size of a task: %1 bytes").arg(sizeof(Task));
+#ifdef __GLIBC__
+    const auto task_bytes = measure_heap_usage<Task>();
+    const auto qobject_task_bytes = measure_heap_usage<QObjectTask>();
+    qInfo().noquote() << QString("Heap usage of %1 tasks: %2 bytes, %3 bytes as QObject (%4 and %5 bytes per task)")
+        .arg(task_count)
+        .arg(task_bytes)
+        .arg(qobject_task_bytes)
+        .arg(task_bytes / task_count)
+        .arg(qobject_task_bytes / task_count);
+    QVERIFY(task_bytes < qobject_task_bytes);
+#else
+    QSKIP("Measuring the heap usage requires glibc.");
+#endif
+}
+
+QTEST_GUILESS_MAIN(BenchmarkTask)
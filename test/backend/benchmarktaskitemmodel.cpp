@@ -0,0 +1,122 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarktaskitemmodel.h"
+
+#include <utility>
+#include <vector>
+
+#include <QList>
+#include <QSqlDatabase>
+#include <QString>
+#include <QTest>
+#include <QVariant>
+#include <QtTypes>
+
+#include "../testhelpers.h"
+#include "dataitems/qtdid.h"
+#include "dataitems/task.h"
+#include "models/taskitemmodel.h"
+#include "repositories/startuploader.h"
+#include "repositories/statementcache.h"
+#include "repositories/taskrepository.h"
+#include "utils/initialize.h"
+
+BenchmarkTaskItemModel::BenchmarkTaskItemModel(QObject *parent)
+    : QObject{parent}
+{}
+
+void BenchmarkTaskItemModel::initTestCase() {
+    initialize_qt_meta_types();
+}
+
+/**
+ * The generated dependency graph consists of layers of equal width. Every task
+ * depends on 'fan_in' tasks of the previous layer, so a task of layer n appears
+ * fan_in^n times in the model.
+ */
+void BenchmarkTaskItemModel::initTestCase_data() {
+    QTest::addColumn<int>("layer_width");
+    QTest::addColumn<int>("layer_count");
+    QTest::addColumn<int>("fan_in");
+    QTest::newRow("fan-in 1") << 2000 << 5 << 1;
+    QTest::newRow("fan-in 3") <<  100 << 6 << 3;
+    QTest::newRow("fan-in 8") <<   50 << 4 << 8;
+}
+
+void BenchmarkTaskItemModel::init() {
+    QFETCH_GLOBAL(int, layer_width);
+    QFETCH_GLOBAL(int, layer_count);
+    QFETCH_GLOBAL(int, fan_in);
+
+    // Reopening the in-memory database discards the graph of the previous data row:
+    QVERIFY(TestHelpers::setup_database());
+    const auto task_repository = TaskRepository::create(QSqlDatabase::database().connectionName());
+
+    std::vector<TaskId> previous_layer;
+    this->expected_model_size = 0;
+    qsizetype appearances_per_task = 1;
+    for (int layer=0; layer<layer_count; ++layer) {
+        std::vector<TaskId> current_layer;
+        current_layer.reserve(layer_width);
+        for (int i=0; i<layer_width; ++i) {
+            const Task task(QString("Task %1/%2").arg(layer).arg(i));
+            QVERIFY(task_repository.save(task));
+            if (!previous_layer.empty()) {
+                QList<QVariant> dependents;
+                for (int parent=0; parent<fan_in; ++parent) {
+                    dependents << QVariant::fromValue(previous_layer.at((i + parent) % layer_width));
+                }
+                QVERIFY(task_repository.add_dependents(task.get_uuid(), dependents));
+            }
+            current_layer.push_back(task.get_uuid());
+        }
+        this->expected_model_size += layer_width * appearances_per_task;
+        appearances_per_task *= fan_in;
+        previous_layer = std::move(current_layer);
+    }
+}
+
+void BenchmarkTaskItemModel::cleanupTestCase() {
+    StatementCache::close_connection(QSqlDatabase::database().connectionName());
+}
+
+void BenchmarkTaskItemModel::benchmark_load_task_data() {
+    QFETCH_GLOBAL(int, layer_width);
+    QFETCH_GLOBAL(int, layer_count);
+    const auto connection_name = QSqlDatabase::database().connectionName();
+
+    qsizetype task_count = 0;
+    QBENCHMARK {
+        task_count = StartupLoader::load_tasks(connection_name).tasks.size();
+    }
+    QCOMPARE(task_count, static_cast<qsizetype>(layer_width) * layer_count);
+}
+
+void BenchmarkTaskItemModel::benchmark_load_model() const {
+    const auto connection_name = QSqlDatabase::database().connectionName();
+
+    qsizetype model_size = 0;
+    QBENCHMARK {
+        TaskItemModel model(connection_name);
+        model_size = model.get_size();
+    }
+    QCOMPARE(model_size, this->expected_model_size);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkTaskItemModel)
@@ -0,0 +1,45 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <QObject>
+#include <QTest>
+#include <QtTypes>
+
+class BenchmarkTaskItemModel : public QObject
+{
+    Q_OBJECT
+
+private:
+    qsizetype expected_model_size = 0;
+
+public:
+    explicit BenchmarkTaskItemModel(QObject *parent = nullptr);
+
+private slots:
+    // Test setup/cleanup:
+    static void initTestCase();
+    static void initTestCase_data();
+    void init();
+    static void cleanupTestCase();
+
+    // Benchmark functions:
+    static void benchmark_load_task_data();
+    void benchmark_load_model() const;
+};
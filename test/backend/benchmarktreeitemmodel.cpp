@@ -0,0 +1,113 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "benchmarktreeitemmodel.h"
+
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include <QList>
+#include <QModelIndex>
+#include <QPair>
+#include <QString>
+#include <QTest>
+
+#include "../testhelpers.h"
+#include "dataitems/qtdid.h"
+#include "dataitems/qtditemdatarole.h"
+#include "dataitems/uniquedataitem.h"
+#include "testmodelwrappers.h"
+
+namespace {
+
+constexpr int child_count = 10000;
+
+} // anonymous namespace
+
+
+BenchmarkTreeItemModel::BenchmarkTreeItemModel(QObject *parent)
+    : QObject{parent}
+{}
+
+/**
+ * The model consists of a single top level item with many children, each of which has
+ * one child of its own. Thus, resolving the parent of a grandchild requires the row of
+ * a child among all of its siblings. A second top level item can depend on the first one.
+ */
+void BenchmarkTreeItemModel::initTestCase() {
+    std::vector<std::unique_ptr<UniqueDataItem>> data_items;
+    QList<QPair<QtdId, QtdId>> parents;
+    data_items.push_back(std::make_unique<TestHelpers::TestTag>("wide"));
+    const auto wide_uuid = data_items.front()->get_uuid();
+    for (int i=0; i<child_count; i++) {
+        auto child = std::make_unique<TestHelpers::TestTag>(QString("child %1").arg(i));
+        auto grandchild = std::make_unique<TestHelpers::TestTag>(QString("grandchild %1").arg(i));
+        parents.append({child->get_uuid(), wide_uuid});
+        parents.append({grandchild->get_uuid(), child->get_uuid()});
+        data_items.push_back(std::move(child));
+        data_items.push_back(std::move(grandchild));
+    }
+    data_items.push_back(std::make_unique<TestHelpers::TestTag>("dependent"));
+
+    this->model = std::make_unique<TreeItemModelTestWrapper>();
+    QVERIFY(this->model->load_tree(std::move(data_items), parents));
+}
+
+/**
+ * Visit the children the way QAbstractItemModelTester does: create the index of every
+ * row, descend into it and check that the parent of its child leads back to it.
+ */
+void BenchmarkTreeItemModel::benchmark_traverse_wide_node() const {
+    const auto wide_index = this->model->index(0, 0);
+    QCOMPARE(this->model->rowCount(wide_index), child_count);
+
+    int consistent_rows = 0;
+    QBENCHMARK {
+        consistent_rows = 0;
+        for (int row=0; row<child_count; row++) {
+            const auto child_index = this->model->index(row, 0, wide_index);
+            const auto grandchild_index = this->model->index(0, 0, child_index);
+            const auto parent_index = this->model->parent(grandchild_index);
+            if (parent_index == child_index && this->model->parent(parent_index) == wide_index) {
+                consistent_rows++;
+            }
+        }
+    }
+    QCOMPARE(consistent_rows, child_count);
+}
+
+/**
+ * Checking a new dependency for cycles must not traverse the many descendants of the
+ * prerequisite.
+ */
+void BenchmarkTreeItemModel::benchmark_add_dependency_on_wide_node() const {
+    const auto wide_uuid = this->model->index(0, 0).data(UuidRole).value<QtdId>();
+    const auto dependent_index = this->model->index(1, 0);
+    const auto dependent_uuid = dependent_index.data(UuidRole).value<QtdId>();
+
+    int dependency_count = 0;
+    QBENCHMARK {
+        if (this->model->clone_tree_node(wide_uuid, dependent_uuid)) {
+            dependency_count++;
+        }
+    }
+    QCOMPARE(this->model->rowCount(dependent_index), dependency_count);
+}
+
+QTEST_GUILESS_MAIN(BenchmarkTreeItemModel)
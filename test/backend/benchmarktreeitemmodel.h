@@ -0,0 +1,44 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#pragma once
+
+#include <memory>
+
+#include <QObject>
+#include <QTest>
+
+#include "testmodelwrappers.h"
+
+class BenchmarkTreeItemModel : public QObject
+{
+    Q_OBJECT
+
+private:
+    std::unique_ptr<TreeItemModelTestWrapper> model;
+
+public:
+    explicit BenchmarkTreeItemModel(QObject *parent = nullptr);
+
+private slots:
+    void initTestCase();
+
+    // Benchmark functions:
+    void benchmark_traverse_wide_node() const;
+    void benchmark_add_dependency_on_wide_node() const;
+};
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -25,6 +25,7 @@
 #include <QTest>
 
 #include "../testhelpers.h"
+#include "repositories/statementcache.h"
 #include "utils/initialize.h"
 
 PersistedTreeItemModelsTestBase::PersistedTreeItemModelsTestBase(QObject *parent)
@@ -41,7 +42,7 @@ void PersistedTreeItemModelsTestBase::initTestCase() {
 }
 
 void PersistedTreeItemModelsTestBase::cleanupTestCase() {
-    QSqlDatabase::database().close();
+    StatementCache::close_connection(QSqlDatabase::database().connectionName());
 }
 
 void PersistedTreeItemModelsTestBase::init() {
@@ -19,16 +19,25 @@
 #include "testfilteredtaskitemmodel.h"
 
 #include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
 
 #include <QLoggingCategory>
+#include <QAbstractItemModel>
+#include <QPersistentModelIndex>
 #include <QSet>
 #include <QSignalSpy>
+#include <QStringList>
 #include <QSqlDatabase>
 #include <QTest>
 
 #include "../testhelpers.h"
 #include "dataitems/qtdid.h"
 #include "dataitems/qtditemdatarole.h"
+#include "dataitems/task.h"
+#include "models/mainpagemodelfilter.h"
+#include "models/taskcolumnstore.h"
 #include "models/taskitemmodel.h"
 #include "utils/initialize.h"
 
@@ -51,6 +60,19 @@ void check_parents(const QAbstractItemModel& model) {
     }
 }
 
+std::unique_ptr<FilteredTaskItemModel> create_main_page_model(
+    TaskItemModel* base_model,
+    const FilteredTaskItemModel::TaskFilterFunction& filter_function,
+    std::optional<TaskColumnStore::Filter> column_filter = std::nullopt
+) {
+    auto model = std::make_unique<FilteredTaskItemModel>(filter_function);
+    if (column_filter.has_value()) {
+        model->set_column_filter(base_model->get_column_store(), *column_filter);
+    }
+    model->setSourceModel(base_model);
+    return model;
+}
+
 } // namespace
 
 
@@ -73,6 +95,7 @@ void TestFilteredTaskItemModel::init() {
     QCOMPARE(this->base_model->rowCount(), 3);
 
     TestHelpers::setup_proxy_item_model(this->model, this->base_model.get());
+    this->model->set_search_index(this->base_model->get_search_index());
     this->model->clear_search_string();
     this->spy = std::make_unique<QSignalSpy>(
         this->model.get(),
@@ -138,6 +161,41 @@ void TestFilteredTaskItemModel::test_no_search_string_matches() const {
     QCOMPARE(this->model->rowCount(), 0);
 }
 
+void TestFilteredTaskItemModel::test_search_index_finds_candidates() const {
+    const auto* search_index = this->base_model->get_search_index();
+    QVERIFY(search_index != nullptr);
+
+    const auto candidates = search_index->find_candidates({"toothpaste"});
+    QVERIFY(candidates.has_value());
+    QCOMPARE(*candidates, {TaskId("dc1f5ff8-db45-6630-9340-13a7d860d910")});
+
+    QCOMPARE(search_index->find_candidates({"qqq"}).value(), QSet<TaskId>());
+    QVERIFY(!search_index->find_candidates({"a", "pr"}).has_value());
+
+    // The candidates of the proxy are updated for the changed tasks only:
+    this->model->set_search_string("renew");
+    QCOMPARE(this->model->rowCount(), 0);
+
+    const qsizetype task_count = search_index->get_size();
+    QVERIFY(this->base_model->create_task("Renew passport"));
+    QCOMPARE(search_index->get_size(), task_count + 1);
+    const auto new_task = TestHelpers::find_model_index_by_display_role(*this->base_model, "Renew passport");
+    QCOMPARE(
+        search_index->find_candidates({"passport"}).value(),
+        QSet<TaskId>({new_task.data(UuidRole).value<TaskId>()})
+    );
+    QCOMPARE(TestHelpers::get_display_roles(*this->model), {"Renew passport"});
+
+    QVERIFY(this->base_model->setData(new_task, "Renew identity card", Qt::DisplayRole));
+    QCOMPARE(search_index->find_candidates({"passport"}).value(), QSet<TaskId>());
+    QCOMPARE(TestHelpers::get_display_roles(*this->model), {"Renew identity card"});
+    QVERIFY(this->base_model->setData(new_task, "Replace identity card", Qt::DisplayRole));
+    QCOMPARE(this->model->rowCount(), 0);
+
+    QVERIFY(this->base_model->removeRow(new_task.row(), new_task.parent()));
+    QCOMPARE(search_index->get_size(), task_count);
+}
+
 void TestFilteredTaskItemModel::test_no_filter() const {
     this->model->clear_search_string();
     TestHelpers::assert_model_equality(
@@ -217,6 +275,153 @@ void TestFilteredTaskItemModel::test_adding_children_to_cloned_items_in_base_mod
     check_parents(*this->model);
 };
 
+void TestFilteredTaskItemModel::test_inserting_rows_does_not_reset_proxy() const {
+    const QSignalSpy reset_spy(this->model.get(), &QAbstractItemModel::modelReset);
+    const QSignalSpy insert_spy(this->model.get(), &QAbstractItemModel::rowsInserted);
+
+    const auto base_parent = TestHelpers::find_model_index_by_display_role(*this->base_model, "Do chores");
+    QVERIFY(this->base_model->create_task("Water plants", {base_parent}));
+
+    QCOMPARE(reset_spy.count(), 0);
+    QCOMPARE(insert_spy.count(), 1);
+
+    const auto proxy_parent = this->model->mapFromSource(base_parent);
+    QCOMPARE(TestHelpers::get_display_roles(*this->model, proxy_parent), {"Water plants"});
+    check_parents(*this->model);
+}
+
+void TestFilteredTaskItemModel::test_removing_a_clone_keeps_the_row_of_the_remaining_clones() const {
+    // "Fix printer" is reached from three top level tasks but shown only once:
+    this->model->set_search_string("printer");
+    QCOMPARE(TestHelpers::get_display_roles(*this->model), {"Fix printer"});
+    const QPersistentModelIndex proxy_index = this->model->index(0, 0);
+
+    const QSignalSpy reset_spy(this->model.get(), &QAbstractItemModel::modelReset);
+    const QSignalSpy remove_spy(this->model.get(), &QAbstractItemModel::rowsRemoved);
+    const QSignalSpy insert_spy(this->model.get(), &QAbstractItemModel::rowsInserted);
+
+    const auto base_parent = TestHelpers::find_model_index_by_display_role(*this->base_model, "Print shopping list");
+    const auto base_clone = TestHelpers::find_model_index_by_display_role(*this->base_model, "Fix printer", base_parent);
+    QVERIFY(base_clone.isValid());
+    QVERIFY(this->base_model->removeRow(base_clone.row(), base_clone.parent()));
+
+    QCOMPARE(reset_spy.count(), 0);
+    QCOMPARE(remove_spy.count(), 0);
+    QCOMPARE(insert_spy.count(), 0);
+    QVERIFY(proxy_index.isValid());
+    QCOMPARE(proxy_index.row(), 0);
+    QCOMPARE(proxy_index.data(), "Fix printer");
+    QCOMPARE(this->model->rowCount(), 1);
+    QVERIFY(this->model->mapToSource(proxy_index).isValid());
+    check_parents(*this->model);
+}
+
+void TestFilteredTaskItemModel::test_ancestors_are_reevaluated_on_row_changes() const {
+    std::unique_ptr<FilteredTaskItemModel> actionable_model;
+    TestHelpers::setup_proxy_item_model(actionable_model, this->base_model.get(), is_task_actionable);
+    QCOMPARE(TestHelpers::get_display_roles(*actionable_model), {"Fix printer"});
+
+    const QString parent_title = "Answer landlords mail";
+    const auto base_parent = TestHelpers::find_model_index_by_display_role(*this->base_model, parent_title);
+    QVERIFY(this->base_model->removeRow(0, base_parent));
+    QCOMPARE(
+        TestHelpers::sort(TestHelpers::get_display_roles(*actionable_model)),
+        TestHelpers::sort(QStringList({"Fix printer", parent_title}))
+    );
+
+    QVERIFY(this->base_model->create_task("Write reply", {base_parent}));
+    QCOMPARE(
+        TestHelpers::sort(TestHelpers::get_display_roles(*actionable_model)),
+        TestHelpers::sort(QStringList({"Fix printer", "Write reply"}))
+    );
+    check_parents(*actionable_model);
+}
+
+void TestFilteredTaskItemModel::test_column_filters_match_filter_functions() const {
+    const std::vector<std::pair<FilteredTaskItemModel::TaskFilterFunction, TaskColumnStore::Filter>> filters = {
+        {is_task_open,            open_task_filter},
+        {is_task_actionable,      actionable_task_filter},
+        {is_task_in_open_project, open_project_filter},
+        {is_task_closed,          closed_task_filter}
+    };
+    const auto check_filters = [this, &filters]() {
+        for (const auto& [filter_function, column_filter] : filters) {
+            const auto function_model = create_main_page_model(this->base_model.get(), filter_function);
+            const auto column_model = create_main_page_model(this->base_model.get(), filter_function, column_filter);
+            QCOMPARE(
+                TestHelpers::sort(TestHelpers::get_display_roles(*column_model)),
+                TestHelpers::sort(TestHelpers::get_display_roles(*function_model))
+            );
+        }
+    };
+    QCOMPARE(this->base_model->get_column_store()->get_size(), qsizetype{8});
+    check_filters();
+
+    const auto project = TestHelpers::find_model_index_by_display_role(*this->base_model, "Cook meal");
+    QVERIFY(this->base_model->setData(project, Task::closed, ActiveRole));
+    check_filters();
+
+    const auto parent = TestHelpers::find_model_index_by_display_role(*this->base_model, "Answer landlords mail");
+    const auto column_model = create_main_page_model(this->base_model.get(), is_task_actionable, actionable_task_filter);
+    QVERIFY(this->base_model->removeRow(0, parent));
+    QCOMPARE(
+        TestHelpers::sort(TestHelpers::get_display_roles(*column_model)),
+        TestHelpers::sort(QStringList({"Fix printer", "Answer landlords mail"}))
+    );
+    check_filters();
+}
+
+void TestFilteredTaskItemModel::test_data_changes_update_rows_incrementally() const {
+    const auto open_model = create_main_page_model(this->base_model.get(), is_task_open, open_task_filter);
+    const auto project_model = create_main_page_model(this->base_model.get(), is_task_in_open_project, open_project_filter);
+    // Rows are mapped lazily, views fetch them before they are changed:
+    check_parents(*open_model);
+    check_parents(*project_model);
+    open_model->set_filter_roles(task_filter_roles);
+    project_model->set_filter_roles(task_filter_roles);
+    const QSignalSpy reset_spy(open_model.get(), &QAbstractItemModel::modelReset);
+    const QSignalSpy remove_spy(open_model.get(), &QAbstractItemModel::rowsRemoved);
+    const QSignalSpy insert_spy(open_model.get(), &QAbstractItemModel::rowsInserted);
+    const QSignalSpy data_changed_spy(open_model.get(), &QAbstractItemModel::dataChanged);
+    const QSignalSpy project_remove_spy(project_model.get(), &QAbstractItemModel::rowsRemoved);
+
+    const auto groceries = TestHelpers::find_model_index_by_display_role(*this->base_model, "Buy groceries");
+    QVERIFY(this->base_model->setData(groceries, "Buy food", Qt::DisplayRole));
+    QCOMPARE(remove_spy.count() + insert_spy.count(), 0);
+    QCOMPARE(data_changed_spy.count(), 1);
+    QCOMPARE(data_changed_spy.last().at(0).toModelIndex(), open_model->mapFromSource(groceries));
+
+    const auto recipe = TestHelpers::find_model_index_by_display_role(*this->base_model, "Print recipe");
+    QVERIFY(this->base_model->setData(recipe, Task::closed, ActiveRole));
+    QCOMPARE(remove_spy.count(), 1);
+    QCOMPARE(insert_spy.count(), 1);
+    const auto proxy_project = TestHelpers::find_model_index_by_display_role(*open_model, "Cook meal");
+    QCOMPARE(
+        TestHelpers::sort(TestHelpers::get_display_roles(*open_model, proxy_project)),
+        TestHelpers::sort(QStringList({"Buy food", "Fix printer", "Print shopping list", "Fix printer"}))
+    );
+
+    QVERIFY(this->base_model->setData(recipe, Task::open, ActiveRole));
+    QVERIFY(TestHelpers::find_model_index_by_display_role(*open_model, "Print recipe").isValid());
+    check_parents(*open_model);
+
+    open_model->set_selected_tags({TagId("54c1f21d-bb9a-41df-9658-5111e153f745")});
+    const auto reset_count = reset_spy.count();
+    QCOMPARE(TestHelpers::get_display_roles(*open_model), {"Buy food"});
+    const auto printer = TestHelpers::find_model_index_by_display_role(*this->base_model, "Fix printer");
+    QVERIFY(this->base_model->add_tag(printer, TagId("54c1f21d-bb9a-41df-9658-5111e153f745")));
+    QVERIFY(TestHelpers::find_model_index_by_display_role(*open_model, "Fix printer").isValid());
+    QCOMPARE(reset_spy.count(), reset_count);
+    check_parents(*open_model);
+
+    const auto project = TestHelpers::find_model_index_by_display_role(*this->base_model, "Cook meal");
+    QVERIFY(this->base_model->setData(project, Task::closed, ActiveRole));
+    QCOMPARE(project_remove_spy.count(), 1);
+    QCOMPARE(TestHelpers::get_display_roles(*project_model), TestHelpers::get_display_roles(
+        *create_main_page_model(this->base_model.get(), is_task_in_open_project)
+    ));
+}
+
 void TestFilteredTaskItemModel::test_parents_become_childless_if_no_child_matches() const {
     this->model->set_search_string("meal");
     QCOMPARE(
@@ -267,4 +472,28 @@ void TestFilteredTaskItemModel::test_filter_by_tag_and_search_string() const {
     );
 }
 
+void TestFilteredTaskItemModel::test_tag_bitsets_of_column_store() const {
+    const auto function_model = create_main_page_model(this->base_model.get(), is_task_open);
+    const auto column_model = create_main_page_model(this->base_model.get(), is_task_open, open_task_filter);
+    const QSignalSpy function_spy(function_model.get(), &FilteredTaskItemModel::filtered_tags_changed);
+    const QSignalSpy column_spy(column_model.get(), &FilteredTaskItemModel::filtered_tags_changed);
+
+    const QSet<TagId> selected_tags({TagId("54c1f21d-bb9a-41df-9658-5111e153f745")});
+    function_model->set_selected_tags(selected_tags);
+    column_model->set_selected_tags(selected_tags);
+    QCOMPARE(TestHelpers::get_display_roles(*column_model), {"Buy groceries"});
+    QCOMPARE(TestHelpers::get_display_roles(*column_model), TestHelpers::get_display_roles(*function_model));
+
+    function_model->set_search_string("groceries");
+    column_model->set_search_string("groceries");
+    QCOMPARE(column_spy.count(), 1);
+    QCOMPARE(column_spy.last().at(0).value<QSet<TagId>>(), selected_tags);
+    QCOMPARE(column_spy.last().at(0).value<QSet<TagId>>(), function_spy.last().at(0).value<QSet<TagId>>());
+
+    const auto task = TestHelpers::find_model_index_by_display_role(*this->base_model, "Fix printer");
+    QVERIFY(this->base_model->add_tag(task, *selected_tags.begin()));
+    column_model->set_search_string("printer");
+    QCOMPARE(TestHelpers::get_display_roles(*column_model), {"Fix printer"});
+}
+
 QTEST_GUILESS_MAIN(TestFilteredTaskItemModel)
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -50,6 +50,7 @@ private slots:
     void test_filter_with_quotes() const;
     void test_filter_for_task_details() const;
     void test_no_search_string_matches() const;
+    void test_search_index_finds_candidates() const;
     void test_no_filter() const;
 
     void test_filter_independent_of_filter_word_order() const;
@@ -57,10 +58,16 @@ private slots:
 
     void test_modifying_base_model_propagates_to_proxy() const;
     void test_adding_children_to_cloned_items_in_base_model() const;
+    void test_inserting_rows_does_not_reset_proxy() const;
+    void test_removing_a_clone_keeps_the_row_of_the_remaining_clones() const;
+    void test_ancestors_are_reevaluated_on_row_changes() const;
+    void test_column_filters_match_filter_functions() const;
+    void test_data_changes_update_rows_incrementally() const;
 
     void test_parents_become_childless_if_no_child_matches() const;
     void test_matching_children_are_kept_if_parents_are_filtered_out() const;
 
     void test_filter_by_tag_selection() const;
     void test_filter_by_tag_and_search_string() const;
+    void test_tag_bitsets_of_column_store() const;
 };
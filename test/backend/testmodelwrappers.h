@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -30,4 +30,5 @@ class TreeItemModelTestWrapper : public TreeItemModel {
 public:
     using TreeItemModel::create_tree_node;
     using TreeItemModel::clone_tree_node;
+    using TreeItemModel::load_tree;
 };
@@ -29,6 +29,7 @@
 
 #include "../qmlinterface.h"
 #include "../testhelpers.h"
+#include "repositories/statementcache.h"
 #include "utils/initialize.h"
 
 TestQmlInterface::TestQmlInterface(QObject *parent)
@@ -71,7 +72,7 @@ QAbstractItemModel* TestQmlInterface::get_model(const char *model_name) const {
 }
 
 void TestQmlInterface::cleanupTestCase() {
-    QSqlDatabase::database().close();
+    StatementCache::close_connection(QSqlDatabase::database().connectionName());
 }
 
 void TestQmlInterface::test_model_size() const {
@@ -91,4 +91,13 @@ void TestQtdId::test_database_serialization() {
     QCOMPARE(fetch_query.value(0).value<QtdId>(), test_id);
 }
 
+void TestQtdId::test_hash_independent_of_string_representation() {
+    const auto lower_case_id = QtdId("c7ad2469-c662-43b5-9f3e-3e05ee26efaf");
+    const auto upper_case_id = QtdId("{C7AD2469-C662-43B5-9F3E-3E05EE26EFAF}");
+    QCOMPARE(lower_case_id, upper_case_id);
+    QCOMPARE(qHash(lower_case_id), qHash(upper_case_id));
+    QCOMPARE(qHash(lower_case_id, 42), qHash(upper_case_id, 42));
+    QVERIFY(qHash(lower_case_id) != qHash(QtdId::create()));
+}
+
 QTEST_GUILESS_MAIN(TestQtdId)
@@ -43,4 +43,5 @@ private slots:
     static void test_implicit_qvariant_conversion();
     static void test_qvariant_conversion();
     static void test_database_serialization();
+    static void test_hash_independent_of_string_representation();
 };
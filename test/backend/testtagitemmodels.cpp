@@ -26,6 +26,7 @@
 #include <QLoggingCategory>
 #include <QObject>
 #include <QPersistentModelIndex>
+#include <QSignalSpy>
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QString>
@@ -95,6 +96,19 @@ void TestTagItemModels::test_remove_single_row_with_nested_children() const {
     QCOMPARE(this->model->rowCount(), 1);
 }
 
+void TestTagItemModels::test_remove_items_of_different_parents() const {
+    const auto work_index = TestHelpers::find_model_index_by_display_role(*this->model, "Work");
+    QVERIFY(this->model->remove_items({
+        TestHelpers::find_model_index_by_display_role(*this->model, "Vacation"),
+        TestHelpers::find_model_index_by_display_role(*this->model, "Mails"),
+        work_index
+    }));
+    QCOMPARE(ModelIteration::count_model_rows(this->model.get()), 6);
+    QCOMPARE(ModelIteration::count_model_rows(this->flat_model.get()), 6);
+    QVERIFY(!TestHelpers::find_model_index_by_display_role(*this->model, "Vacation").isValid());
+    QCOMPARE(this->model->rowCount(), 1);
+}
+
 void TestTagItemModels::test_create_toplevel_tag() const {
     const int old_row_count = this->model->rowCount();
     const int old_row_count_flat_model = this->flat_model->rowCount();
@@ -347,4 +361,22 @@ void TestTagItemModels::test_changing_parent_to_different_subtree() const {
     QCOMPARE(this->model->rowCount(new_parent_index), new_parent_child_count + 1);
 }
 
+void TestTagItemModels::test_flat_model_is_updated_without_reset() const {
+    const QSignalSpy reset_spy(this->flat_model.get(), &QAbstractItemModel::modelReset);
+    const QSignalSpy insert_spy(this->flat_model.get(), &QAbstractItemModel::rowsInserted);
+    const QSignalSpy remove_spy(this->flat_model.get(), &QAbstractItemModel::rowsRemoved);
+
+    const auto index = TestHelpers::find_model_index_by_display_role(*this->model, "Fun");
+    const auto new_parent_index = TestHelpers::find_model_index_by_display_role(*this->model, "Work");
+    QVERIFY(this->model->change_parent(index, new_parent_index.data(UuidRole).value<TagId>()));
+
+    QCOMPARE(reset_spy.count(), 0);
+    QCOMPARE(insert_spy.count(), 1);
+    QCOMPARE(remove_spy.count(), 1);
+
+    // "Fun" is inserted together with its children "Vacation" and "Hobbies":
+    const auto inserted_rows = insert_spy.first();
+    QCOMPARE(inserted_rows.at(2).toInt() - inserted_rows.at(1).toInt() + 1, 3);
+}
+
 QTEST_GUILESS_MAIN(TestTagItemModels)
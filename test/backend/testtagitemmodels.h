@@ -62,6 +62,7 @@ private slots:
     void test_remove_single_row() const;
     void test_remove_rows_with_children() const;
     void test_remove_single_row_with_nested_children() const;
+    void test_remove_items_of_different_parents() const;
     void test_create_toplevel_tag() const;
     void test_create_tag_with_parent() const;
     void test_data_change_of_toplevel_item() const;
@@ -71,4 +72,5 @@ private slots:
     void test_removing_parent() const;
     void test_changing_parent_to_grand_parent() const;
     void test_changing_parent_to_different_subtree() const;
+    void test_flat_model_is_updated_without_reset() const;
 };
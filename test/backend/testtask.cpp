@@ -0,0 +1,75 @@
+/**
+ * Copyright 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ *
+ * This file is part of qtd.
+ *
+ * qtd is free software: you can redistribute it and/or modify it under the
+ * terms of the GNU General Public License as published by the Free Software
+ * Foundation, either version 3 of the License, or (at your option) any later
+ * version.
+ *
+ * qtd is distributed in the hope that it will be useful, but WITHOUT ANY
+ * WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS FOR
+ * A PARTICULAR PURPOSE. See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * qtd. If not, see <https://www.gnu.org/licenses/>.
+ */
+
+#include "testtask.h"
+
+#include <memory>
+#include <vector>
+
+#include <QPointer>
+#include <QString>
+#include <QTest>
+#include <QTextCursor>
+#include <QTextDocument>
+
+#include "dataitems/qtditemdatarole.h"
+#include "dataitems/task.h"
+#include "utils/initialize.h"
+
+TestTask::TestTask(QObject *parent)
+    : QObject{parent}
+{}
+
+void TestTask::initTestCase() {
+    initialize_qt_meta_types();
+}
+
+void TestTask::test_text_documents_are_created_lazily() {
+    Task task("Lazy task", Task::Status::open, {}, {}, {}, "<p>Initial description</p>");
+    QCOMPARE(task.get_data(DetailsRole).toString(), "Initial description");
+
+    const QPointer<QTextDocument> document = task.get_text_document();
+    QVERIFY(document != nullptr);
+    QCOMPARE(task.get_text_document(), document.data());
+    QTextCursor(document).insertText("Edited: ");
+
+    std::vector<std::unique_ptr<Task>> other_tasks;
+    for (qsizetype i = 0; i < Task::max_open_text_documents; ++i) {
+        other_tasks.push_back(std::make_unique<Task>(QString("Task %1").arg(i)));
+        QVERIFY(other_tasks.back()->get_text_document() != nullptr);
+    }
+
+    QVERIFY(document.isNull());
+    QCOMPARE(task.get_data(DetailsRole).toString(), "Edited: Initial description");
+    QCOMPARE(task.get_text_document()->toPlainText(), "Edited: Initial description");
+}
+
+void TestTask::test_search_text_follows_title_and_description() {
+    Task task("Call Bob", Task::Status::open, {}, {}, {}, "<p>About the <b>Offer</b></p>");
+    QCOMPARE(task.get_search_text(), "call bob\nabout the offer");
+    QCOMPARE(task.get_data(SearchTextRole).toString(), task.get_search_text());
+
+    task.set_title("Call Alice");
+    QCOMPARE(task.get_search_text(), "call alice\nabout the offer");
+
+    task.get_text_document()->setPlainText("New Details");
+    QCOMPARE(task.get_data(DetailsRole).toString(), "New Details");
+    QCOMPARE(task.get_search_text(), "call alice\nnew details");
+}
+
+QTEST_GUILESS_MAIN(TestTask)
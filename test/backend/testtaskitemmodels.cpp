@@ -19,12 +19,24 @@
 #include "testtaskitemmodels.h"
 
 #include <memory>
+#include <utility>
 
+#include <QAbstractItemModel>
+#include <QCoreApplication>
 #include <QDateTime>
+#include <QList>
 #include <QObject>
+#include <QPointer>
 #include <QSet>
+#include <QSignalSpy>
+#include <QSqlDatabase>
+#include <QSqlQuery>
 #include <QString>
+#include <QStringList>
+#include <QTemporaryFile>
 #include <QTest>
+#include <QTextDocument>
+#include <QThread>
 
 #include "../testhelpers.h"
 #include "dataitems/qtdid.h"
@@ -32,7 +44,12 @@
 #include "dataitems/task.h"
 #include "models/tagitemmodel.h"
 #include "persistedtreeitemmodelstestbase.h"
+#include "repositories/databaseworker.h"
+#include "repositories/persistencequeue.h"
+#include "repositories/startuploader.h"
+#include "repositories/statementcache.h"
 #include "utils/modeliteration.h"
+#include "utils/query_utilities.h"
 
 TestTaskItemModel::TestTaskItemModel(QObject *parent)
     : PersistedTreeItemModelsTestBase{parent}
@@ -59,8 +76,11 @@ void TestTaskItemModel::test_initial_dataset_represented_correctly() const {
 }
 
 void TestTaskItemModel::test_model_stores_text_documents() const {
-    QEXPECT_FAIL("", "Document storage is not yet implemented!", Continue);
-    QVERIFY(this->model->data(this->model->index(0, 0), DocumentRole).isValid());
+    const auto test_index = this->model->index(0, 0);
+    const auto document = test_index.data(DocumentRole).value<QPointer<QTextDocument>>();
+    QVERIFY(document != nullptr);
+    QCOMPARE(document->toPlainText(), test_index.data(DetailsRole).toString());
+    QCOMPARE(test_index.data(DocumentRole).value<QPointer<QTextDocument>>(), document);
 }
 
 void TestTaskItemModel::test_data_change_of_unique_task() const {
@@ -118,6 +138,80 @@ void TestTaskItemModel::test_data_change_of_cloned_task() const {
     TestTaskItemModel::assert_index_equality(test_index, test_index_clone);
 }
 
+void TestTaskItemModel::test_coalesced_data_changes_of_cloned_task() const {
+    QList<QModelIndex> clones;
+    for (const auto* parent_title : {"Print shopping list", "Print recipe", "Answer landlords mail"}) {
+        clones.append(TestHelpers::find_model_index_by_display_role(
+            *this->model,
+            "Fix printer",
+            TestHelpers::find_model_index_by_display_role(*this->model, parent_title)
+        ));
+        QVERIFY(clones.last().isValid());
+    }
+
+    this->model->set_change_coalescing(true);
+    const QSignalSpy data_changed_spy(this->model.get(), &QAbstractItemModel::dataChanged);
+    QVERIFY(this->model->setData(clones.first(), "Fix printer and refill ink", Qt::DisplayRole));
+    QVERIFY(this->model->setData(clones.last(), Task::closed, ActiveRole));
+    QVERIFY(this->model->setData(clones.first(), "Replace printer", Qt::DisplayRole));
+    QCOMPARE(clones.last().data().toString(), "Replace printer");
+    QCOMPARE(data_changed_spy.count(), 0);
+
+    QCoreApplication::processEvents();
+    QCOMPARE(data_changed_spy.count(), clones.size());
+    QSet<QModelIndex> changed_parents;
+    for (const auto& arguments : data_changed_spy) {
+        const auto top_left = arguments.at(0).toModelIndex();
+        QCOMPARE(arguments.at(1).toModelIndex(), top_left);
+        QCOMPARE(top_left.data().toString(), "Replace printer");
+        const auto roles = arguments.at(2).value<QList<int>>();
+        QCOMPARE(roles.size(), 2);
+        QVERIFY(roles.contains(Qt::DisplayRole));
+        QVERIFY(roles.contains(ActiveRole));
+        changed_parents.insert(top_left.parent());
+    }
+    QCOMPARE(changed_parents.size(), clones.size());
+
+    QVERIFY(this->model->setData(clones.first(), Task::open, ActiveRole));
+    this->model->set_change_coalescing(false);
+    QCOMPARE(data_changed_spy.count(), 2 * clones.size());
+}
+
+void TestTaskItemModel::test_coalesced_data_changes_of_separate_rows() const {
+    QCOMPARE(this->model->rowCount(), 3);
+    const auto due_date = QDateTime::fromString("2026-01-01 12:00:00", Qt::ISODate);
+
+    this->model->set_change_coalescing(true);
+    const QSignalSpy data_changed_spy(this->model.get(), &QAbstractItemModel::dataChanged);
+    QVERIFY(this->model->setData(this->model->index(2, 0), due_date, DueRole));
+    QVERIFY(this->model->setData(this->model->index(0, 0), due_date, DueRole));
+    QCoreApplication::processEvents();
+
+    // The unchanged row in between is not announced:
+    QCOMPARE(data_changed_spy.count(), 2);
+    QSet<int> changed_rows;
+    for (const auto& arguments : data_changed_spy) {
+        const auto top_left = arguments.at(0).toModelIndex();
+        QCOMPARE(arguments.at(1).toModelIndex(), top_left);
+        changed_rows.insert(top_left.row());
+    }
+    QCOMPARE(changed_rows, QSet<int>({0, 2}));
+
+    QVERIFY(this->model->setData(this->model->index(1, 0), due_date, DueRole));
+    QVERIFY(this->model->setData(this->model->index(0, 0), "Cook dinner", Qt::DisplayRole));
+    QVERIFY(this->model->setData(this->model->index(2, 0), due_date.addDays(1), DueRole));
+    this->model->set_change_coalescing(false);
+
+    QCOMPARE(data_changed_spy.count(), 3);
+    const auto& arguments = data_changed_spy.last();
+    QCOMPARE(arguments.at(0).toModelIndex(), this->model->index(0, 0));
+    QCOMPARE(arguments.at(1).toModelIndex(), this->model->index(2, 0));
+    const auto roles = arguments.at(2).value<QList<int>>();
+    QCOMPARE(roles.size(), 2);
+    QVERIFY(roles.contains(Qt::DisplayRole));
+    QVERIFY(roles.contains(DueRole));
+}
+
 void TestTaskItemModel::test_remove_rows() const {
     const auto index_to_remove = TestHelpers::find_model_index_by_display_role(
         *this->model, "Buy groceries"
@@ -132,6 +226,35 @@ void TestTaskItemModel::test_remove_rows() const {
     QCOMPARE(this->model->rowCount(index_parent), number_of_siblings);
 }
 
+void TestTaskItemModel::test_remove_items_of_different_parents() const {
+    const auto find = [this](const QString& title, const QString& parent_title) {
+        return TestHelpers::find_model_index_by_display_role(
+            *this->model,
+            title,
+            TestHelpers::find_model_index_by_display_role(*this->model, parent_title)
+        );
+    };
+    const QModelIndexList indexes_to_remove = {
+        find("Fix printer", "Answer landlords mail"),
+        find("Fix printer", "Print shopping list"),
+        find("Print shopping list", "Buy groceries"),
+        TestHelpers::find_model_index_by_display_role(*this->model, "Do chores")
+    };
+    for (const auto& index : indexes_to_remove) {
+        QVERIFY(index.isValid());
+    }
+
+    const QSignalSpy removal_spy(this->model.get(), &QAbstractItemModel::rowsRemoved);
+    QVERIFY(this->model->remove_items(indexes_to_remove));
+    QCOMPARE(removal_spy.count(), 4);
+    QCOMPARE(this->model->get_size(), ModelIteration::count_model_rows(this->model.get()));
+    QCOMPARE(
+        TestHelpers::sort(TestHelpers::get_display_roles(*this->model)),
+        TestHelpers::sort(QStringList({"Cook meal", "Buy groceries", "Print recipe", "Fix printer", "Answer landlords mail"}))
+    );
+    QVERIFY(!this->model->remove_items({QModelIndex()}));
+}
+
 void TestTaskItemModel::test_create_task() const {
     const auto parent1 = TestHelpers::find_model_index_by_display_role(
         *this->model, "Buy groceries"
@@ -176,6 +299,27 @@ void TestTaskItemModel::test_add_dependency() const {
     QCOMPARE(this->model->rowCount(cloned_index), this->model->rowCount(index_buy_groceries));
 }
 
+void TestTaskItemModel::test_sibling_order_survives_reload() const {
+    const auto parent = TestHelpers::find_model_index_by_display_role(*this->model, "Answer landlords mail");
+    const auto child = TestHelpers::find_model_index_by_display_role(*this->model, "Buy groceries");
+    QVERIFY(this->model->add_dependency(parent, child));
+
+    // The new child was created before its sibling, but depends on the parent since later:
+    const QStringList expected_order = {"Fix printer", "Buy groceries"};
+    const auto get_children = [](const QAbstractItemModel& model, const QModelIndex& parent) {
+        QStringList result;
+        for (int row=0; row<model.rowCount(parent); row++) {
+            result.append(model.index(row, 0, parent).data().toString());
+        }
+        return result;
+    };
+    QCOMPARE(get_children(*this->model, parent), expected_order);
+
+    const TaskItemModel reloaded_model(this->get_db_connection_name());
+    const auto reloaded_parent = TestHelpers::find_model_index_by_display_role(reloaded_model, "Answer landlords mail");
+    QCOMPARE(get_children(reloaded_model, reloaded_parent), expected_order);
+}
+
 void TestTaskItemModel::test_adding_dependency_with_invalid_parent() const {
     const auto child = TestHelpers::find_model_index_by_display_role(
         *this->model, "Buy groceries"
@@ -237,10 +381,11 @@ void TestTaskItemModel::assert_model_persistence() const {
 
     TestHelpers::setup_item_model(model_reloaded_from_db, this->get_db_connection_name());
 
+    // Documents differ per task instance, DetailsRole compares their content instead:
     TestHelpers::assert_model_equality(
         *model_reloaded_from_db,
         *this->model,
-        {Qt::DisplayRole, UuidRole, ActiveRole, StartRole, DueRole, DetailsRole, DocumentRole, TagsRole},
+        {Qt::DisplayRole, UuidRole, ActiveRole, StartRole, DueRole, DetailsRole, TagsRole},
         TestHelpers::compare_indices_by_uuid
     );
 }
@@ -320,6 +465,45 @@ void TestTaskItemModel::test_adding_and_removing_tags() const {
     QCOMPARE(index.data(TagsRole).value<QSet<TagId>>(), {initial_tag});
 }
 
+void TestTaskItemModel::test_adding_and_removing_tags_of_many_tasks() const {
+    const auto find = [this](const QString& title, const QString& parent_title) {
+        return TestHelpers::find_model_index_by_display_role(
+            *this->model,
+            title,
+            TestHelpers::find_model_index_by_display_role(*this->model, parent_title)
+        );
+    };
+    const auto cook_meal = TestHelpers::find_model_index_by_display_role(*this->model, "Cook meal");
+    const auto fix_printer = find("Fix printer", "Print recipe");
+    const auto fix_printer_clone = find("Fix printer", "Answer landlords mail");
+    const QModelIndexList indexes = {cook_meal, fix_printer, fix_printer_clone, find("Buy groceries", "Cook meal")};
+    const auto initial_tag = TagId("10173aba-edd8-4049-a41c-74f28581c31f");
+    const auto test_tag = TagId("0baf3308-5899-44ad-9e55-a8e83f2b82ee");
+
+    QVERIFY(!this->model->add_tags(indexes, {test_tag, TagId::create()}));
+    QCOMPARE(fix_printer.data(TagsRole).value<QSet<TagId>>(), {});
+
+    const QSignalSpy data_changed_spy(this->model.get(), &QAbstractItemModel::dataChanged);
+    QVERIFY(this->model->add_tags(indexes, {test_tag, initial_tag}));
+    QCOMPARE(cook_meal.data(TagsRole).value<QSet<TagId>>(), QSet({initial_tag, test_tag}));
+    QCOMPARE(fix_printer_clone.data(TagsRole).value<QSet<TagId>>(), QSet({initial_tag, test_tag}));
+
+    QSet<QModelIndex> changed_parents;
+    for (const auto& arguments : data_changed_spy) {
+        const auto top_left = arguments.at(0).toModelIndex();
+        QCOMPARE(arguments.at(1).toModelIndex().parent(), top_left.parent());
+        QVERIFY(!changed_parents.contains(top_left.parent()));
+        changed_parents.insert(top_left.parent());
+    }
+    QVERIFY(changed_parents.contains(fix_printer.parent()));
+    QVERIFY(changed_parents.contains(fix_printer_clone.parent()));
+    this->assert_model_persistence();
+
+    QVERIFY(this->model->remove_tags(indexes, {test_tag}));
+    QCOMPARE(cook_meal.data(TagsRole).value<QSet<TagId>>(), {initial_tag});
+    QCOMPARE(fix_printer.data(TagsRole).value<QSet<TagId>>(), {initial_tag});
+}
+
 void TestTaskItemModel::test_task_creation_with_unknown_parents() const {
     auto valid_parent = TestHelpers::find_model_index_by_display_role(
         *this->model,
@@ -338,5 +522,299 @@ void TestTaskItemModel::test_task_creation_with_unknown_parents() const {
     QCOMPARE(0, this->model->rowCount(valid_parent));
 }
 
+void TestTaskItemModel::test_statements_are_prepared_once() const {
+    const auto index = TestHelpers::find_model_index_by_display_role(*this->model, "Buy groceries");
+    QVERIFY(this->model->setData(index, "Buy fruit", Qt::DisplayRole));
+    const auto statistics = StatementCache::get_statistics(this->get_db_connection_name());
+
+    QVERIFY(this->model->setData(index, "Buy vegetables", Qt::DisplayRole));
+    QVERIFY(this->model->setData(index, "Buy groceries", Qt::DisplayRole));
+    const auto new_statistics = StatementCache::get_statistics(this->get_db_connection_name());
+    QCOMPARE(new_statistics.misses, statistics.misses);
+    QCOMPARE(new_statistics.hits, statistics.hits + 2);
+}
+
+void TestTaskItemModel::test_write_behind_mode() const {
+    PersistenceQueue queue(this->get_db_connection_name());
+    const QSignalSpy failure_spy(&queue, &PersistenceQueue::flush_failed);
+    this->model->set_persistence_queue(&queue);
+
+    const auto index = TestHelpers::find_model_index_by_display_role(*this->model, "Cook meal");
+    QVERIFY(this->model->setData(index, "Cook", Qt::DisplayRole));
+    QVERIFY(this->model->setData(index, "Cook dinner", Qt::DisplayRole));
+    QVERIFY(this->model->add_tag(index, TagId("0baf3308-5899-44ad-9e55-a8e83f2b82ee")));
+    QCOMPARE(index.data().toString(), "Cook dinner");
+    QCOMPARE(queue.get_pending_count(), 2);
+
+    QSqlQuery query(QSqlDatabase::database(this->get_db_connection_name()));
+    QVERIFY(query.exec("SELECT COUNT(*) FROM tasks WHERE title = 'Cook dinner'"));
+    QVERIFY(query.next());
+    QCOMPARE(query.value(0).toInt(), 0);
+
+    QVERIFY(queue.flush());
+    QCOMPARE(queue.get_pending_count(), 0);
+    this->assert_model_persistence();
+
+    const auto renamed_index = TestHelpers::find_model_index_by_display_role(*this->model, "Cook dinner");
+    const auto unknown_tag = TagId::create();
+    QVERIFY(this->model->setData(renamed_index, "Cook lunch", Qt::DisplayRole));
+    QVERIFY(this->model->add_tag(renamed_index, unknown_tag));
+    QVERIFY(!queue.flush());
+    QCOMPARE(failure_spy.count(), 1);
+
+    // Only the failing operation is reverted:
+    QVERIFY(!TestHelpers::find_model_index_by_display_role(*this->model, "Cook dinner").isValid());
+    const auto reloaded_index = TestHelpers::find_model_index_by_display_role(*this->model, "Cook lunch");
+    QVERIFY(reloaded_index.isValid());
+    QVERIFY(!reloaded_index.data(TagsRole).value<QSet<TagId>>().contains(unknown_tag));
+    this->assert_model_persistence();
+
+    this->model->set_persistence_queue(nullptr);
+}
+
+void TestTaskItemModel::test_migration_of_text_ids() {
+    const QString connection_name = "text_ids";
+    {
+        auto database = QSqlDatabase::addDatabase("QSQLITE", connection_name);
+        database.setDatabaseName(":memory:");
+        QVERIFY(database.open());
+
+        QSqlQuery query(database);
+        const QStringList legacy_queries = {
+            "CREATE TABLE tags (uuid VARCHAR(36) PRIMARY KEY, name VARCHAR(128) NOT NULL, "
+                "color VARCHAR(9), parent_uuid VARCHAR(36), last_modified VARCHAR(30));",
+            "CREATE TABLE tasks (uuid VARCHAR(36) PRIMARY KEY, title VARCHAR(1024) NOT NULL, "
+                "status VARCHAR(10) NOT NULL DEFAULT 'open', start_datetime VARCHAR(30), "
+                "due_datetime VARCHAR(30), resolve_datetime VARCHAR(30), content_text TEXT, "
+                "last_modified VARCHAR(30));",
+            "CREATE TABLE task_media (task_uuid VARCHAR(36), media_hash VARCHAR(64), "
+                "last_modified VARCHAR(30));",
+            "CREATE TABLE tag_assignments (task_uuid VARCHAR(36), tag_uuid VARCHAR(36), "
+                "last_modified VARCHAR(30));",
+            "CREATE TABLE dependencies (dependent_uuid VARCHAR(36), prerequisite_uuid VARCHAR(36), "
+                "last_modified VARCHAR(30));",
+            "INSERT INTO tags (uuid, name) VALUES ('54c1f21d-bb9a-41df-9658-5111e153f745', 'Shopping');",
+            "INSERT INTO tasks (uuid, title) VALUES ('84723285-3f82-a463-3274-d65afa4bafc9', 'Cook meal');",
+            "INSERT INTO tasks (uuid, title) VALUES ('dc1f5ff8-db45-6630-9340-13a7d860d910', 'Buy groceries');",
+            "INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) "
+                "VALUES ('84723285-3f82-a463-3274-d65afa4bafc9', 'dc1f5ff8-db45-6630-9340-13a7d860d910');",
+            "INSERT INTO tag_assignments (task_uuid, tag_uuid) "
+                "VALUES ('dc1f5ff8-db45-6630-9340-13a7d860d910', '54c1f21d-bb9a-41df-9658-5111e153f745');"
+        };
+        for (const auto& query_str : legacy_queries) {
+            QVERIFY(query.exec(query_str));
+        }
+
+        QVERIFY(QueryUtilities::create_tables_if_not_exist(connection_name));
+        QVERIFY(query.exec("SELECT COUNT(*) FROM tasks WHERE length(uuid) = 16;"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toInt(), 2);
+
+        const TaskItemModel migrated_model(connection_name);
+        QCOMPARE(migrated_model.rowCount(), 1);
+        const auto parent_index = migrated_model.index(0, 0);
+        QCOMPARE(parent_index.data(UuidRole).value<TaskId>(), TaskId("84723285-3f82-a463-3274-d65afa4bafc9"));
+        QCOMPARE(migrated_model.rowCount(parent_index), 1);
+
+        const auto child_index = migrated_model.index(0, 0, parent_index);
+        QCOMPARE(child_index.data().toString(), "Buy groceries");
+        QCOMPARE(
+            child_index.data(TagsRole).value<QSet<TagId>>(),
+            QSet<TagId>({TagId("54c1f21d-bb9a-41df-9658-5111e153f745")})
+        );
+        StatementCache::close_connection(connection_name);
+    }
+    QSqlDatabase::removeDatabase(connection_name);
+}
+
+void TestTaskItemModel::test_write_behind_mode_with_database_worker() {
+    const QString connection_name = "worker_source";
+    QTemporaryFile database_file;
+    QVERIFY(database_file.open());
+    {
+        auto database = QSqlDatabase::addDatabase("QSQLITE", connection_name);
+        database.setDatabaseName(database_file.fileName());
+        QVERIFY(database.open());
+        QVERIFY(QueryUtilities::create_tables_if_not_exist(connection_name));
+
+        TaskItemModel model(connection_name);
+        {
+            DatabaseWorker worker(connection_name);
+            const auto thread_check = worker.run<bool>([](const QString& worker_connection_name) {
+                return QThread::currentThread() != QCoreApplication::instance()->thread()
+                       && QSqlDatabase::database(worker_connection_name).isOpen();
+            });
+            QVERIFY(thread_check.result());
+
+            PersistenceQueue queue(connection_name);
+            queue.set_database_worker(&worker);
+            model.set_persistence_queue(&queue);
+
+            QVERIFY(model.create_task("Written by worker"));
+            QVERIFY(model.setData(model.index(0, 0), "Renamed by worker", Qt::DisplayRole));
+            QCOMPARE(queue.get_pending_count(), 2);
+            queue.flush_async();
+            QCOMPARE(queue.get_pending_count(), 0);
+            QVERIFY(queue.flush());
+
+            model.set_persistence_queue(nullptr);
+        }
+
+        QSqlQuery query(database);
+        QVERIFY(query.exec("SELECT title FROM tasks;"));
+        QVERIFY(query.next());
+        QCOMPARE(query.value(0).toString(), "Renamed by worker");
+        QVERIFY(!query.next());
+        query.finish();
+        StatementCache::close_connection(connection_name);
+    }
+    QSqlDatabase::removeDatabase(connection_name);
+}
+
+void TestTaskItemModel::test_failed_async_flush_reloads_consistent_data() {
+    const QString connection_name = "failing_worker_source";
+    QTemporaryFile database_file;
+    QVERIFY(database_file.open());
+    {
+        auto database = QSqlDatabase::addDatabase("QSQLITE", connection_name);
+        database.setDatabaseName(database_file.fileName());
+        QVERIFY(database.open());
+        QVERIFY(QSqlQuery(database).exec("PRAGMA foreign_keys = ON;"));
+        QVERIFY(QueryUtilities::create_tables_if_not_exist(connection_name));
+
+        TaskItemModel model(connection_name);
+        QVERIFY(model.create_task("Written before"));
+        {
+            DatabaseWorker worker(connection_name);
+            PersistenceQueue queue(connection_name);
+            const QSignalSpy failure_spy(&queue, &PersistenceQueue::flush_failed);
+            queue.set_flush_delay(60000);
+            queue.set_database_worker(&worker);
+            model.set_persistence_queue(&queue);
+
+            QVERIFY(model.create_task("Created in failed batch"));
+            const auto failed_task = TestHelpers::find_model_index_by_display_role(model, "Created in failed batch");
+            const auto unknown_tag = TagId::create();
+            QVERIFY(model.add_tag(failed_task, unknown_tag));
+            queue.flush_async();
+
+            // Queued before the failure is reported:
+            QVERIFY(model.setData(failed_task, "Renamed after failed batch", Qt::DisplayRole));
+            const auto other_task = TestHelpers::find_model_index_by_display_role(model, "Written before");
+            QVERIFY(model.setData(other_task, "Renamed after failure", Qt::DisplayRole));
+            QCOMPARE(queue.get_pending_count(), 2);
+
+            QTRY_COMPARE(failure_spy.count(), 1);
+            QCOMPARE(queue.get_pending_count(), 0);
+
+            // Only the unknown tag is lost; the other operations of the batch have been written again:
+            const auto renamed_task = TestHelpers::find_model_index_by_display_role(model, "Renamed after failed batch");
+            QVERIFY(renamed_task.isValid());
+            QVERIFY(!renamed_task.data(TagsRole).value<QSet<TagId>>().contains(unknown_tag));
+            QVERIFY(TestHelpers::find_model_index_by_display_role(model, "Renamed after failure").isValid());
+
+            const TaskItemModel reloaded_model(connection_name);
+            TestHelpers::assert_model_equality(
+                model,
+                reloaded_model,
+                {Qt::DisplayRole, UuidRole, ActiveRole, TagsRole},
+                TestHelpers::compare_indices_by_uuid
+            );
+            QVERIFY(queue.flush());
+            QCOMPARE(failure_spy.count(), 1);
+            model.set_persistence_queue(nullptr);
+        }
+        StatementCache::close_connection(connection_name);
+    }
+    QSqlDatabase::removeDatabase(connection_name);
+}
+
+void TestTaskItemModel::test_tag_and_task_writes_share_the_queue() {
+    const QString connection_name = "shared_queue_source";
+    QTemporaryFile database_file;
+    QVERIFY(database_file.open());
+    {
+        auto database = QSqlDatabase::addDatabase("QSQLITE", connection_name);
+        database.setDatabaseName(database_file.fileName());
+        QVERIFY(database.open());
+        QVERIFY(QSqlQuery(database).exec("PRAGMA foreign_keys = ON;"));
+        QVERIFY(QueryUtilities::create_tables_if_not_exist(connection_name));
+
+        TagItemModel tags(connection_name);
+        TaskItemModel tasks(connection_name);
+        {
+            DatabaseWorker worker(connection_name);
+            PersistenceQueue queue(connection_name);
+            const QSignalSpy failure_spy(&queue, &PersistenceQueue::flush_failed);
+            queue.set_flush_delay(60000);
+            queue.set_database_worker(&worker);
+            tags.set_persistence_queue(&queue);
+            tasks.set_persistence_queue(&queue);
+
+            QVERIFY(tags.create_tag("Written by worker"));
+            const auto tag = tags.index(0, 0).data(UuidRole).value<TagId>();
+            QVERIFY(tasks.create_task("Tagged first"));
+            QVERIFY(tasks.add_tag(tasks.index(0, 0), tag));
+            QCOMPARE(queue.get_pending_count(), 3);
+
+            // Nothing is written on the connection of the models:
+            QSqlQuery query(database);
+            QVERIFY(query.exec("SELECT COUNT(*) FROM tags;"));
+            QVERIFY(query.next());
+            QCOMPARE(query.value(0).toInt(), 0);
+            query.finish();
+
+            queue.flush_async();
+            // Removing the tag must not overtake the assignment queued before:
+            QVERIFY(tasks.create_task("Tagged last"));
+            QVERIFY(tasks.add_tag(TestHelpers::find_model_index_by_display_role(tasks, "Tagged last"), tag));
+            QVERIFY(tags.removeRows(0, 1, QModelIndex()));
+            QVERIFY(queue.flush());
+            QCOMPARE(failure_spy.count(), 0);
+
+            QVERIFY(query.exec("SELECT COUNT(*) FROM tasks;"));
+            QVERIFY(query.next());
+            QCOMPARE(query.value(0).toInt(), 2);
+            QVERIFY(query.exec("SELECT COUNT(*) FROM tag_assignments;"));
+            QVERIFY(query.next());
+            QCOMPARE(query.value(0).toInt(), 0);
+            query.finish();
+
+            tags.set_persistence_queue(nullptr);
+            tasks.set_persistence_queue(nullptr);
+        }
+        StatementCache::close_connection(connection_name);
+    }
+    QSqlDatabase::removeDatabase(connection_name);
+}
+
+void TestTaskItemModel::test_startup_loader_reads_database_file_concurrently() const {
+    const QString connection_name = "loader_source";
+    QTemporaryFile database_file;
+    QVERIFY(database_file.open());
+    QSqlQuery copy_query;
+    QVERIFY(copy_query.exec(QString("VACUUM INTO '%1';").arg(database_file.fileName())));
+    {
+        auto database = QSqlDatabase::addDatabase("QSQLITE", connection_name);
+        database.setDatabaseName(database_file.fileName());
+        QVERIFY(database.open());
+
+        auto snapshot = StartupLoader::load(connection_name);
+        QVERIFY(QSqlDatabase::connectionNames().filter("_reader_").isEmpty());
+
+        const TagItemModel tags(connection_name, std::move(snapshot.tags));
+        QCOMPARE(tags.rowCount(), TagItemModel(this->get_db_connection_name()).rowCount());
+
+        const TaskItemModel tasks(connection_name, std::move(snapshot.task_data));
+        TestHelpers::assert_model_equality(
+            tasks,
+            *this->model,
+            {Qt::DisplayRole, UuidRole, ActiveRole, StartRole, DueRole, DetailsRole, TagsRole, SearchTextRole},
+            TestHelpers::compare_indices_by_uuid
+        );
+        StatementCache::close_connection(connection_name);
+    }
+    QSqlDatabase::removeDatabase(connection_name);
+}
 
 QTEST_GUILESS_MAIN(TestTaskItemModel)
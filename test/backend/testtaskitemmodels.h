@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -67,12 +67,24 @@ private slots:
     void test_model_stores_text_documents() const;
     void test_data_change_of_unique_task() const;
     void test_data_change_of_cloned_task() const;
+    void test_coalesced_data_changes_of_cloned_task() const;
+    void test_coalesced_data_changes_of_separate_rows() const;
     void test_remove_rows() const;
+    void test_remove_items_of_different_parents() const;
     void test_create_task() const;
     void test_add_dependency() const;
+    void test_sibling_order_survives_reload() const;
     void test_adding_dependency_with_invalid_parent() const;
     void test_can_not_create_dependency_cycle() const;
     void test_adding_and_removing_tags() const;
+    void test_adding_and_removing_tags_of_many_tasks() const;
     void test_task_creation_with_unknown_parents() const;
+    void test_statements_are_prepared_once() const;
+    void test_write_behind_mode() const;
+    static void test_migration_of_text_ids();
+    static void test_write_behind_mode_with_database_worker();
+    static void test_failed_async_flush_reloads_consistent_data();
+    static void test_tag_and_task_writes_share_the_queue();
+    void test_startup_loader_reads_database_file_concurrently() const;
 
 };
@@ -20,17 +20,24 @@
 
 #include <memory>
 #include <utility>
+#include <vector>
 
+#include <QAbstractItemModel>
 #include <QAbstractItemModelTester>
+#include <QList>
 #include <QObject>
+#include <QPair>
 #include <QSet>
 #include <QSignalSpy>
+#include <QString>
+#include <QStringList>
 #include <QTest>
 #include <QVariant>
 
 #include "../testhelpers.h"
 #include "dataitems/qtdid.h"
 #include "dataitems/qtditemdatarole.h"
+#include "dataitems/uniquedataitem.h"
 #include "testmodelwrappers.h"
 #include "utils/modeliteration.h"
 
@@ -270,6 +277,172 @@ void TestTreeItemModel::test_remove_child_of_clone() {
     QCOMPARE(this->model_indices_of_row_change_signals(spy), expected_signalling_indices);
 }
 
+void TestTreeItemModel::test_clone_tree_node_rejects_dependency_cycles() {
+    const auto A = this->model->index(0, 0).data(UuidRole).value<QtdId>();
+    const auto B = this->model->index(1, 0).data(UuidRole).value<QtdId>();
+    const auto B1 = this->model->index(0, 0, this->model->index(1, 0)).data(UuidRole).value<QtdId>();
+    auto C_tag = std::make_unique<TestHelpers::TestTag>("C");
+    auto D_tag = std::make_unique<TestHelpers::TestTag>("D");
+    const auto C = C_tag->get_uuid();
+    const auto D = D_tag->get_uuid();
+    QVERIFY(this->model->create_tree_node(std::move(C_tag)));
+    QVERIFY(this->model->create_tree_node(std::move(D_tag)));
+
+    // Each new dependency goes against the order in which the items were created:
+    QVERIFY(this->model->clone_tree_node(B, D));
+    QVERIFY(this->model->clone_tree_node(A, B));
+    QVERIFY(!this->model->clone_tree_node(A, A));
+    QVERIFY(!this->model->clone_tree_node(B, A));
+    QVERIFY(!this->model->clone_tree_node(D, A));
+
+    QVERIFY(this->model->clone_tree_node(C, A));
+    QVERIFY(!this->model->clone_tree_node(D, C));
+    QVERIFY(this->model->clone_tree_node(C, B1));
+    QCOMPARE(this->model->get_size(), ModelIteration::count_model_rows(this->model.get()));
+}
+
+void TestTreeItemModel::test_load_tree_builds_all_clones_at_once() {
+    auto A = std::make_unique<TestHelpers::TestTag>("A");
+    auto B = std::make_unique<TestHelpers::TestTag>("B");
+    auto C = std::make_unique<TestHelpers::TestTag>("C");
+    auto D = std::make_unique<TestHelpers::TestTag>("D");
+    const QList<QPair<QtdId, QtdId>> parents = {
+        {C->get_uuid(), A->get_uuid()},
+        {D->get_uuid(), B->get_uuid()},
+        {D->get_uuid(), C->get_uuid()}
+    };
+
+    // Children are passed before their parents on purpose:
+    std::vector<std::unique_ptr<UniqueDataItem>> data_items;
+    data_items.push_back(std::move(D));
+    data_items.push_back(std::move(C));
+    data_items.push_back(std::move(A));
+    data_items.push_back(std::move(B));
+
+    const QSignalSpy reset_spy(this->model.get(), SIGNAL(modelReset()));
+    const QSignalSpy insert_spy(this->model.get(), SIGNAL(rowsInserted(const QModelIndex&, int, int)));
+    QVERIFY(this->model->load_tree(std::move(data_items), parents));
+    QCOMPARE(reset_spy.count(), 1);
+    QCOMPARE(insert_spy.count(), 0);
+
+    const auto A_index = this->model->index(0, 0);
+    const auto B_index = this->model->index(1, 0);
+    const auto C_index = this->model->index(0, 0, A_index);
+    this->verify_item(A_index, "A", 1, QModelIndex());
+    this->verify_item(B_index, "B", 1, QModelIndex());
+    this->verify_item(C_index, "C", 1, A_index);
+    this->verify_item(this->model->index(0, 0, B_index), "D", 0, B_index);
+    this->verify_item(this->model->index(0, 0, C_index), "D", 0, C_index);
+    QCOMPARE(this->model->rowCount(), 2);
+    QCOMPARE(this->model->get_size(), 5);
+    QCOMPARE(this->model->get_size(), ModelIteration::count_model_rows(this->model.get()));
+
+    // Clones created by the bulk load are kept in sync like all others:
+    QVERIFY(this->model->create_tree_node(
+        std::make_unique<TestHelpers::TestTag>("E"),
+        this->model->index(0, 0, B_index).data(UuidRole).value<QtdId>()
+    ));
+    QCOMPARE(this->model->rowCount(this->model->index(0, 0, C_index)), 1);
+}
+
+void TestTreeItemModel::test_load_tree_rejects_dependency_cycles() {
+    auto A = std::make_unique<TestHelpers::TestTag>("A");
+    auto B = std::make_unique<TestHelpers::TestTag>("B");
+    auto C = std::make_unique<TestHelpers::TestTag>("C");
+    const QList<QPair<QtdId, QtdId>> parents = {
+        {B->get_uuid(), A->get_uuid()},
+        {C->get_uuid(), B->get_uuid()},
+        {A->get_uuid(), C->get_uuid()}
+    };
+
+    std::vector<std::unique_ptr<UniqueDataItem>> data_items;
+    data_items.push_back(std::move(A));
+    data_items.push_back(std::move(B));
+    data_items.push_back(std::move(C));
+
+    QVERIFY(!this->model->load_tree(std::move(data_items), parents));
+    QCOMPARE(this->model->rowCount(), 0);
+    QCOMPARE(this->model->get_size(), 0);
+}
+
+void TestTreeItemModel::test_rows_removed_handlers_see_remaining_siblings() {
+    // Without a model tester, the children of B are not visited before the removal:
+    TreeItemModelTestWrapper model;
+    auto A_tag = std::make_unique<TestHelpers::TestTag>("A");
+    auto B_tag = std::make_unique<TestHelpers::TestTag>("B");
+    const auto A = A_tag->get_uuid();
+    const auto B = B_tag->get_uuid();
+    QVERIFY(model.create_tree_node(std::move(A_tag)));
+    QVERIFY(model.create_tree_node(std::move(B_tag)));
+    for (const auto* name : {"B1", "B2", "B3", "B4", "B5"}) {
+        QVERIFY(model.create_tree_node(std::make_unique<TestHelpers::TestTag>(name), B));
+    }
+    QVERIFY(model.clone_tree_node(B, A));
+    const auto B_index = model.index(1, 0);
+    const auto clone_index = model.index(0, 0, model.index(0, 0));
+
+    QList<QStringList> children_seen_by_handler;
+    QObject::connect(
+        &model, &QAbstractItemModel::rowsRemoved, &model,
+        [&model, &children_seen_by_handler](const QModelIndex& parent) {
+            QStringList names;
+            for (int row=0; row<model.rowCount(parent); row++) {
+                names.append(model.index(row, 0, parent).data().toString());
+            }
+            children_seen_by_handler.append(names);
+        }
+    );
+
+    QVERIFY(model.removeRows(1, 2, B_index));
+    const QStringList expected_children = {"B1", "B4", "B5"};
+    QCOMPARE(children_seen_by_handler, QList<QStringList>({expected_children, expected_children}));
+    QCOMPARE(model.get_size(), 5);
+    QCOMPARE(model.index(2, 0, clone_index).data().toString(), "B5");
+}
+
+void TestTreeItemModel::test_graph_signals_announce_destroyed_items_and_relations() {
+    const auto A = this->model->index(0, 0).data(UuidRole).value<QtdId>();
+    const auto B = this->model->index(1, 0).data(UuidRole).value<QtdId>();
+    const auto B1 = this->model->index(0, 0, this->model->index(1, 0)).data(UuidRole).value<QtdId>();
+    QList<QPair<QtdId, QtdId>> added_relations;
+    QObject::connect(
+        this->model.get(), &TreeItemModel::relation_added, this->model.get(),
+        [&added_relations](const QtdId& parent, const QtdId& child) {
+            added_relations.append({parent, child});
+        }
+    );
+    QVERIFY(this->model->clone_tree_node(B, A));
+    QCOMPARE(added_relations, QList<QPair<QtdId, QtdId>>({{A, B}}));
+
+    QList<QList<QtdId>> destroyed_items;
+    QList<QPair<QtdId, QList<QtdId>>> removed_relations;
+    QObject::connect(
+        this->model.get(), &TreeItemModel::items_destroyed, this->model.get(),
+        [&destroyed_items](const QList<QtdId>& uuids) { destroyed_items.append(uuids); }
+    );
+    QObject::connect(
+        this->model.get(), &TreeItemModel::relations_removed, this->model.get(),
+        [&removed_relations](const QtdId& parent, const QList<QtdId>& children) {
+            removed_relations.append({parent, children});
+        }
+    );
+
+    // B survives the removal of A, since it is still a top level item:
+    QVERIFY(this->model->removeRows(0, 1));
+    QCOMPARE(destroyed_items, QList<QList<QtdId>>({{A}}));
+    QCOMPARE(
+        removed_relations,
+        (QList<QPair<QtdId, QList<QtdId>>>({{QtdId(), {A}}, {A, {B}}}))
+    );
+
+    destroyed_items.clear();
+    removed_relations.clear();
+    QVERIFY(this->model->removeRows(0, 1));
+    QCOMPARE(destroyed_items, QList<QList<QtdId>>({{B, B1}}));
+    QCOMPARE(removed_relations, (QList<QPair<QtdId, QList<QtdId>>>({{QtdId(), {B}}})));
+    QCOMPARE(this->model->get_item_ids(), QList<QtdId>());
+}
+
 void TestTreeItemModel::verify_item(
     const QModelIndex& item, const QString& name, int child_count, const QModelIndex& parent
 ) {
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -56,4 +56,9 @@ private slots:
     void test_adding_children_to_clones();
     void test_remove_clone();
     void test_remove_child_of_clone();
+    void test_clone_tree_node_rejects_dependency_cycles();
+    void test_load_tree_builds_all_clones_at_once();
+    void test_load_tree_rejects_dependency_cycles();
+    void test_rows_removed_handlers_see_remaining_siblings();
+    void test_graph_signals_announce_destroyed_items_and_relations();
 };
@@ -18,6 +18,7 @@
 
 #include "testtreenodes.h"
 
+#include <cstddef>
 #include <memory>
 #include <utility>
 
@@ -27,9 +28,12 @@
 #include <QTest>
 
 #include "../testhelpers.h"
+#include "dataitems/graphnode.h"
 #include "dataitems/qtdid.h"
 #include "dataitems/qtditemdatarole.h"
+#include "dataitems/treenode.h"
 #include "dataitems/uniquedataitem.h"
+#include "utils/objectpool.h"
 
 TestTreeNodes::TestTreeNodes(QObject *parent)
     : QObject{parent}
@@ -41,11 +45,30 @@ void TestTreeNodes::init() {
 }
 
 void TestTreeNodes::cleanup() {
-    this->root.reset();
+    TreeNode::destroy(this->root);
+    this->root = nullptr;
+    QCOMPARE(this->tree_node_pool.size(), std::size_t{0});
+
+    for (int row=this->root_graph_node->get_child_count()-1; row>=0; row--) {
+        this->remove_graph_child(this->root_graph_node, row);
+    }
+    this->graph_node_pool.destroy(this->root_graph_node);
+    this->root_graph_node = nullptr;
+    QCOMPARE(this->graph_node_pool.size(), std::size_t{0});
 }
 
 void TestTreeNodes::test_add_child() {
-  // Dummy function. Test already carried out in init().
+    const auto initial_child_count = this->root->get_child_count();
+    this->add_graph_child(
+        this->root_graph_node,
+        std::make_unique<TestHelpers::TestTag>("C")
+    );
+    // The tree node is only updated explicitly:
+    QCOMPARE(this->root->get_child_count(), initial_child_count);
+
+    this->root->insert_children(initial_child_count, 1);
+    QCOMPARE(this->root->get_child_count(), initial_child_count+1);
+    TestTreeNodes::verify_item(this->root->get_child(initial_child_count), "C", 0, this->root);
 }
 
 void TestTreeNodes::test_remove_single_child() {
@@ -55,27 +78,42 @@ void TestTreeNodes::test_remove_single_child() {
 
     auto new_item_data = std::make_unique<TestHelpers::TestTag>("about to be deleted");
     QObject* data_ptr = new_item_data.get();
-    this->root->add_child(std::move(new_item_data));
+    this->add_graph_child(this->root_graph_node, std::move(new_item_data));
+    this->root->insert_children(initial_child_count, 1);
     QCOMPARE(this->root->get_child_count(), initial_child_count+1);
 
     QSignalSpy spy(data_ptr, SIGNAL(destroyed(QObject*)));
 
     this->root->remove_children(initial_child_count, 1);
     QCOMPARE(this->root->get_child_count(), initial_child_count);
+    QCOMPARE(spy.count(), 0);
+
+    this->remove_graph_child(this->root_graph_node, initial_child_count);
     QCOMPARE(spy.count(), 1);
     QCOMPARE(spy.takeFirst().at(0).value<QObject*>(), data_ptr);
 }
 
 void TestTreeNodes::test_remove_multiple_children() {
     auto* node_B = this->root->get_child(1);
+    auto* graph_node_B = node_B->get_graph_node();
     const QString name_pattern = "B%1";
     // NOLINTBEGIN(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
     for (int i=2; i<10; i++) {
-        node_B->add_child(std::make_unique<TestHelpers::TestTag>(name_pattern.arg(i)));
+        this->add_graph_child(
+            graph_node_B,
+            std::make_unique<TestHelpers::TestTag>(name_pattern.arg(i))
+        );
     }
+    node_B->insert_children(1, 8);
     QCOMPARE(node_B->get_child_count(), 9);
+    const auto* node_B9 = node_B->get_child(8);
     node_B->remove_children(3, 5);
+    QCOMPARE(node_B9->get_row_in_parent(), 3);
+    for (int row=7; row>=3; row--) {
+        this->remove_graph_child(graph_node_B, row);
+    }
     QCOMPARE(node_B->get_child_count(), 4);
+    QCOMPARE(graph_node_B->get_child_count(), 4);
     // NOLINTEND(cppcoreguidelines-avoid-magic-numbers, readability-magic-numbers)
     TestTreeNodes::verify_item(node_B->get_child(2), "B3", 0, node_B);
     TestTreeNodes::verify_item(node_B->get_child(3), "B9", 0, node_B);
@@ -88,33 +126,50 @@ void TestTreeNodes::test_remove_child_hierarchy() {
 
     const auto* data_ptr = new_item_data.get();
     const QSignalSpy spy(data_ptr, SIGNAL(destroyed(QObject*)));
-    node_A->add_child(std::move(new_item_data));
+    this->add_graph_child(node_A->get_graph_node(), std::move(new_item_data));
+    node_A->insert_children(0, 1);
 
     QCOMPARE(node_A->get_child_count(), 1);
 
     this->root->remove_children(0, 1);
+    this->remove_graph_child(this->root_graph_node, 0);
     QCOMPARE(this->root->get_child_count(), initial_child_count-1);
     QCOMPARE(spy.count(), 1);
     QCOMPARE(spy.first().at(0).value<QObject*>(), data_ptr);
 }
 
-void TestTreeNodes::test_cloning() {
+void TestTreeNodes::test_shared_child() {
     const auto root_child_count = this->root->get_child_count();
-    this->root->add_child(std::make_unique<TestHelpers::TestTag>("C"));
+    auto* graph_node_C = this->add_graph_child(
+        this->root_graph_node,
+        std::make_unique<TestHelpers::TestTag>("C")
+    );
+    this->root->insert_children(root_child_count, 1);
     auto* node_B = this->root->get_child(1);
     const auto B_child_count = node_B->get_child_count();
-    const auto* node_C = this->root->get_child(2);
 
-    node_B->add_child(TreeNode::clone(node_C));
+    node_B->get_graph_node()->add_child(graph_node_C);
+    node_B->insert_children(B_child_count, 1);
+
+    // Tree nodes are created on access only:
+    QVERIFY(graph_node_C->get_tree_nodes().empty());
+    const auto* node_C = this->root->get_child(root_child_count);
     const auto* node_C_clone = node_B->get_child(B_child_count);
 
     QCOMPARE(this->root->get_child_count(), root_child_count+1);
     QCOMPARE(node_B->get_child_count(), B_child_count+1);
+    QCOMPARE(graph_node_C->get_parents().size(), std::size_t{2});
+    QCOMPARE(graph_node_C->get_tree_nodes().size(), std::size_t{2});
+    QVERIFY(node_C != node_C_clone);
+    QCOMPARE(node_C->get_graph_node(), node_C_clone->get_graph_node());
     QCOMPARE(node_C_clone->get_child_count(), node_C->get_child_count());
     QCOMPARE(node_C_clone->get_child_count(), 0);
-    QCOMPARE(node_C->get_parent(), this->root.get());
+    QCOMPARE(node_C->get_parent(), this->root);
     QCOMPARE(node_C_clone->get_parent(), node_B);
     QCOMPARE(node_C_clone->get_data(Qt::DisplayRole), "C");
+
+    node_B->remove_children(B_child_count, 1);
+    QCOMPARE(graph_node_C->get_tree_nodes().size(), std::size_t{1});
 }
 
 void TestTreeNodes::test_set_data() {
@@ -128,6 +183,7 @@ void TestTreeNodes::test_set_data() {
 
     node_A->set_data("new name", Qt::DisplayRole);
     QCOMPARE(node_A->get_data(Qt::DisplayRole), "new name");
+    QCOMPARE(node_A->get_graph_node()->get_data(Qt::DisplayRole), "new name");
     QCOMPARE(node_A->get_data(UuidRole), uuid);
 
     node_A->set_data(QtdId::create(), UuidRole);
@@ -135,11 +191,52 @@ void TestTreeNodes::test_set_data() {
     QCOMPARE(node_A->get_data(UuidRole), uuid);
 }
 
+void TestTreeNodes::test_pool_reuses_slots() {
+    // Root, A, B and B1 have been visited by init():
+    QCOMPARE(this->tree_node_pool.size(), std::size_t{4});
+    const auto capacity = this->tree_node_pool.capacity();
+    auto* graph_node_A = this->root->get_child(0)->get_graph_node();
+
+    TreeNode::destroy(this->root);
+    QCOMPARE(this->tree_node_pool.size(), std::size_t{0});
+    QVERIFY(graph_node_A->get_tree_nodes().empty());
+
+    // New nodes take the place of the destroyed ones:
+    this->root = TreeNode::create(this->tree_node_pool, this->root_graph_node);
+    QCOMPARE(this->root->get_child(0)->get_graph_node(), graph_node_A);
+    QCOMPARE(this->tree_node_pool.size(), std::size_t{2});
+    QCOMPARE(this->tree_node_pool.capacity(), capacity);
+}
+
+GraphNode* TestTreeNodes::add_graph_child(GraphNode* parent, std::unique_ptr<UniqueDataItem> data_item) {
+    auto* child = this->graph_node_pool.create(std::move(data_item));
+    parent->add_child(child);
+    return child;
+}
+
+/**
+ * @brief Remove an edge of the graph like the model does: children without parents are destroyed.
+ */
+void TestTreeNodes::remove_graph_child(GraphNode* parent, int row) {
+    auto* child = parent->take_child(row);
+    if (!child->get_parents().empty()) {
+        return;
+    }
+    for (int child_row=child->get_child_count()-1; child_row>=0; child_row--) {
+        this->remove_graph_child(child, child_row);
+    }
+    this->graph_node_pool.destroy(child);
+}
+
 void TestTreeNodes::setup_dummies() {
-    this->root = TreeNode::create(std::make_unique<UniqueDataItem>());
-    this->root->add_child(std::make_unique<TestHelpers::TestTag>("A"));
-    this->root->add_child(TreeNode::create(std::make_unique<TestHelpers::TestTag>("B")));
-    this->root->get_child(1)->add_child(std::make_unique<TestHelpers::TestTag>("B1"));
+    this->root_graph_node = this->graph_node_pool.create(std::make_unique<UniqueDataItem>());
+    this->add_graph_child(this->root_graph_node, std::make_unique<TestHelpers::TestTag>("A"));
+    auto* graph_node_B = this->add_graph_child(
+        this->root_graph_node,
+        std::make_unique<TestHelpers::TestTag>("B")
+    );
+    this->add_graph_child(graph_node_B, std::make_unique<TestHelpers::TestTag>("B1"));
+    this->root = TreeNode::create(this->tree_node_pool, this->root_graph_node);
 }
 
 void TestTreeNodes::verify_item(TreeNode* item, const QString& name, int child_count, TreeNode* parent) {
@@ -152,11 +249,11 @@ void TestTreeNodes::verify_item(TreeNode* item, const QString& name, int child_c
 }
 
 void TestTreeNodes::verify_dummies() {
-    TestTreeNodes::verify_item(this->root.get(), "", 2, nullptr);
-    TestTreeNodes::verify_item(this->root->get_child(0), "A", 0, this->root.get());
+    TestTreeNodes::verify_item(this->root, "", 2, nullptr);
+    TestTreeNodes::verify_item(this->root->get_child(0), "A", 0, this->root);
 
     auto *node_B = this->root->get_child(1);
-    TestTreeNodes::verify_item(node_B, "B", 1, this->root.get());
+    TestTreeNodes::verify_item(node_B, "B", 1, this->root);
     TestTreeNodes::verify_item(node_B->get_child(0), "B1", 0, node_B);
 }
 
@@ -1,5 +1,5 @@
 /**
- * Copyright 2025 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
+ * Copyright 2025, 2026 xwst <xwst@gmx.net> (F460A9992A713147DEE92958D2020D61FD66FE94)
  *
  * This file is part of qtd.
  *
@@ -21,9 +21,13 @@
 #include <memory>
 
 #include <QObject>
+#include <QString>
 #include <QTest>
 
+#include "dataitems/graphnode.h"
 #include "dataitems/treenode.h"
+#include "dataitems/uniquedataitem.h"
+#include "utils/objectpool.h"
 
 class TestTreeNodes : public QObject
 {
@@ -32,8 +36,13 @@ public:
     explicit TestTreeNodes(QObject *parent = nullptr);
 
 private:
-    std::unique_ptr<TreeNode> root;
+    ObjectPool<GraphNode> graph_node_pool;
+    ObjectPool<TreeNode> tree_node_pool;
+    GraphNode* root_graph_node = nullptr;
+    TreeNode* root = nullptr;
 
+    GraphNode* add_graph_child(GraphNode* parent, std::unique_ptr<UniqueDataItem> data_item);
+    void remove_graph_child(GraphNode* parent, int row);
     void setup_dummies();
     static void verify_item(TreeNode* item, const QString& name, int child_count, TreeNode* parent);
     void verify_dummies();
@@ -49,6 +58,7 @@ private slots:
     void test_remove_single_child();
     void test_remove_multiple_children();
     void test_remove_child_hierarchy();
-    void test_cloning();
+    void test_shared_child();
     void test_set_data();
+    void test_pool_reuses_slots();
 };
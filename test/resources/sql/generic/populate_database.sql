@@ -1,66 +1,66 @@
 -------------------------------------------------
 ---------------------- Tags ---------------------
 -------------------------------------------------
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('0f066904-a88a-4fb3-a098-19594a6135dd','Private',    '#333333',NULL);
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'0f066904a88a4fb3a09819594a6135dd','Private',    '#333333',NULL);
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('fcff6021-2d4c-46df-92bd-6cabe0ae75b1','Fun',        '#FFFF00','0f066904-a88a-4fb3-a098-19594a6135dd');
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'fcff60212d4c46df92bd6cabe0ae75b1','Fun',        '#FFFF00',X'0f066904a88a4fb3a09819594a6135dd');
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('3fd213cf-1c50-47a0-9237-c2da78bf4fcc','Vacation',   '#FF0000','fcff6021-2d4c-46df-92bd-6cabe0ae75b1');
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'3fd213cf1c5047a09237c2da78bf4fcc','Vacation',   '#FF0000',X'fcff60212d4c46df92bd6cabe0ae75b1');
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('10173aba-edd8-4049-a41c-74f28581c31f','Hobbies',    '#00FF00','fcff6021-2d4c-46df-92bd-6cabe0ae75b1');
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'10173abaedd84049a41c74f28581c31f','Hobbies',    '#00FF00',X'fcff60212d4c46df92bd6cabe0ae75b1');
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('18a2d601-712e-4ac4-b655-93c5a288dc99','Chores',     '#559999','0f066904-a88a-4fb3-a098-19594a6135dd');
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'18a2d601712e4ac4b65593c5a288dc99','Chores',     '#559999',X'0f066904a88a4fb3a09819594a6135dd');
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('54c1f21d-bb9a-41df-9658-5111e153f745','Shopping',   '#AA9999','0f066904-a88a-4fb3-a098-19594a6135dd');
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'54c1f21dbb9a41df96585111e153f745','Shopping',   '#AA9999',X'0f066904a88a4fb3a09819594a6135dd');
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('9e711519-7fe7-487b-8f44-e2a31e5ed1e7','Finance',    '',       '0f066904-a88a-4fb3-a098-19594a6135dd');
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'9e7115197fe7487b8f44e2a31e5ed1e7','Finance',    '',       X'0f066904a88a4fb3a09819594a6135dd');
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('c99586cb-3910-4fab-b5a4-d936c9e58471','Work',       '#AAAAAA',NULL);
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'c99586cb39104fabb5a4d936c9e58471','Work',       '#AAAAAA',NULL);
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('b7f5d20c-3ea7-4d20-86e2-3c682fc05756','Mails',      '#FF5555','c99586cb-3910-4fab-b5a4-d936c9e58471');
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'b7f5d20c3ea74d2086e23c682fc05756','Mails',      '#FF5555',X'c99586cb39104fabb5a4d936c9e58471');
 
-INSERT INTO tags (uuid, name, color, parent_uuid) VALUES('0baf3308-5899-44ad-9e55-a8e83f2b82ee','Spreadsheet','#AA5555','c99586cb-3910-4fab-b5a4-d936c9e58471');
+INSERT INTO tags (uuid, name, color, parent_uuid) VALUES(X'0baf3308589944ad9e55a8e83f2b82ee','Spreadsheet','#AA5555',X'c99586cb39104fabb5a4d936c9e58471');
 
 -------------------------------------------------
 --------------------- Tasks ---------------------
 -------------------------------------------------
-INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES('84723285-3f82-a463-3274-d65afa4bafc9','Cook meal',            'open',  '2025-12-01 16:00:00','2025-12-01 18:15:00',''                   ,'');
+INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES(X'847232853f82a4633274d65afa4bafc9','Cook meal',            'open',  '2025-12-01 16:00:00','2025-12-01 18:15:00',''                   ,'');
 
-INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES('dc1f5ff8-db45-6630-9340-13a7d860d910','Buy groceries',        'open',  '',                   '2025-12-01 16:00:00',''                   ,'Also check if toothpaste is empty');
+INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES(X'dc1f5ff8db456630934013a7d860d910','Buy groceries',        'open',  '',                   '2025-12-01 16:00:00',''                   ,'Also check if toothpaste is empty');
 
-INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES('a2225a6f-10ab-2f2a-b7be-e97637804d1b','Print recipe',         'open',  '',                   '2025-12-01 16:00:00',''                   ,'');
+INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES(X'a2225a6f10ab2f2ab7bee97637804d1b','Print recipe',         'open',  '',                   '2025-12-01 16:00:00',''                   ,'');
 
-INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES('3d41278f-4130-a2ae-383b-cbfe2c45f4b5','Print shopping list',  'open',  '',                   '2025-12-01 16:00:00',''                   ,'');
+INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES(X'3d41278f4130a2ae383bcbfe2c45f4b5','Print shopping list',  'open',  '',                   '2025-12-01 16:00:00',''                   ,'');
 
-INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES('ff7cebda-eef6-a632-99e4-1678b69758e7','Check food supplies',  'closed','2024-11-30 00:00:00',''                   ,'2024-11-29 12:17:07','');
+INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES(X'ff7cebdaeef6a63299e41678b69758e7','Check food supplies',  'closed','2024-11-30 00:00:00',''                   ,'2024-11-29 12:17:07','');
 
-INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES('0128dd5a-79a9-4228-b211-fa1724b8d149','Do chores',            'closed','',                   ''                   ,'2024-11-29 16:58:44',REPLACE('- Clean bathroom\n- Sweep\n- …','\n',char(10)));
+INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES(X'0128dd5a79a94228b211fa1724b8d149','Do chores',            'closed','',                   ''                   ,'2024-11-29 16:58:44',REPLACE('- Clean bathroom\n- Sweep\n- …','\n',char(10)));
 
-INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES('125801f4-edc2-5e16-0b66-3e128098a5e5','Answer landlords mail','open',  '',                   '2025-11-30 23:59:59',''                   ,'');
+INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES(X'125801f4edc25e160b663e128098a5e5','Answer landlords mail','open',  '',                   '2025-11-30 23:59:59',''                   ,'');
 
-INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES('0cdaf3ea-9544-71e5-545c-8b5dec226f86','Fix printer',          'open',  '',                   ''                   ,''                   ,'');
+INSERT INTO tasks (uuid, title, status, start_datetime, due_datetime, resolve_datetime, content_text) VALUES(X'0cdaf3ea954471e5545c8b5dec226f86','Fix printer',          'open',  '',                   ''                   ,''                   ,'');
 
-INSERT INTO tag_assignments (task_uuid, tag_uuid) VALUES('84723285-3f82-a463-3274-d65afa4bafc9', '10173aba-edd8-4049-a41c-74f28581c31f');
+INSERT INTO tag_assignments (task_uuid, tag_uuid) VALUES(X'847232853f82a4633274d65afa4bafc9', X'10173abaedd84049a41c74f28581c31f');
 
-INSERT INTO tag_assignments (task_uuid, tag_uuid) VALUES('dc1f5ff8-db45-6630-9340-13a7d860d910', '54c1f21d-bb9a-41df-9658-5111e153f745');
+INSERT INTO tag_assignments (task_uuid, tag_uuid) VALUES(X'dc1f5ff8db456630934013a7d860d910', X'54c1f21dbb9a41df96585111e153f745');
 
-INSERT INTO tag_assignments (task_uuid, tag_uuid) VALUES('ff7cebda-eef6-a632-99e4-1678b69758e7', '54c1f21d-bb9a-41df-9658-5111e153f745');
+INSERT INTO tag_assignments (task_uuid, tag_uuid) VALUES(X'ff7cebdaeef6a63299e41678b69758e7', X'54c1f21dbb9a41df96585111e153f745');
 
-INSERT INTO tag_assignments (task_uuid, tag_uuid) VALUES('0128dd5a-79a9-4228-b211-fa1724b8d149', '18a2d601-712e-4ac4-b655-93c5a288dc99');
+INSERT INTO tag_assignments (task_uuid, tag_uuid) VALUES(X'0128dd5a79a94228b211fa1724b8d149', X'18a2d601712e4ac4b65593c5a288dc99');
 
 -------------------------------------------------
 --------------- Task Dependencies ---------------
 -------------------------------------------------
-INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES('84723285-3f82-a463-3274-d65afa4bafc9','dc1f5ff8-db45-6630-9340-13a7d860d910');
+INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES(X'847232853f82a4633274d65afa4bafc9',X'dc1f5ff8db456630934013a7d860d910');
 
-INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES('84723285-3f82-a463-3274-d65afa4bafc9','a2225a6f-10ab-2f2a-b7be-e97637804d1b');
+INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES(X'847232853f82a4633274d65afa4bafc9',X'a2225a6f10ab2f2ab7bee97637804d1b');
 
-INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES('a2225a6f-10ab-2f2a-b7be-e97637804d1b','0cdaf3ea-9544-71e5-545c-8b5dec226f86');
+INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES(X'a2225a6f10ab2f2ab7bee97637804d1b',X'0cdaf3ea954471e5545c8b5dec226f86');
 
-INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES('3d41278f-4130-a2ae-383b-cbfe2c45f4b5','0cdaf3ea-9544-71e5-545c-8b5dec226f86');
+INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES(X'3d41278f4130a2ae383bcbfe2c45f4b5',X'0cdaf3ea954471e5545c8b5dec226f86');
 
-INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES('125801f4-edc2-5e16-0b66-3e128098a5e5','0cdaf3ea-9544-71e5-545c-8b5dec226f86');
+INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES(X'125801f4edc25e160b663e128098a5e5',X'0cdaf3ea954471e5545c8b5dec226f86');
 
-INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES('dc1f5ff8-db45-6630-9340-13a7d860d910','3d41278f-4130-a2ae-383b-cbfe2c45f4b5');
+INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES(X'dc1f5ff8db456630934013a7d860d910',X'3d41278f4130a2ae383bcbfe2c45f4b5');
 
-INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES('3d41278f-4130-a2ae-383b-cbfe2c45f4b5','ff7cebda-eef6-a632-99e4-1678b69758e7');
+INSERT INTO dependencies (dependent_uuid, prerequisite_uuid) VALUES(X'3d41278f4130a2ae383bcbfe2c45f4b5',X'ff7cebdaeef6a63299e41678b69758e7');
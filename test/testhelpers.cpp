@@ -34,6 +34,7 @@
 
 #include "dataitems/qtdid.h"
 #include "dataitems/qtditemdatarole.h"
+#include "repositories/statementcache.h"
 #include "utils/modeliteration.h"
 #include "utils/query_utilities.h"
 
@@ -75,7 +76,7 @@ bool TestHelpers::setup_database() {
     QSqlDatabase database;
     if (QSqlDatabase::contains()) {
         database = QSqlDatabase::database();
-        database.close();
+        StatementCache::close_connection(database.connectionName());
     } else {
         database = QSqlDatabase::addDatabase("QSQLITE");
         database.setDatabaseName(":memory:");